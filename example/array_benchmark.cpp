@@ -0,0 +1,74 @@
+/**
+    @file
+    array_benchmark.cpp
+
+    @note
+    Arrays of runtime size held inline by node<T[]> versus held by a std::vector node.
+
+    Distributed under the Boost Software License, Version 1.0.
+
+    See accompanying file LICENSE_1_0.txt or copy at
+    http://www.boost.org/LICENSE_1_0.txt
+*/
+
+#include <chrono>
+#include <vector>
+#include <iostream>
+#include <boost/smart_ptr/root_ptr.hpp>
+#include <boost/current_function.hpp>
+
+constexpr std::size_t count = 100000;
+constexpr std::size_t length = 16;
+constexpr std::size_t passes = 20;
+
+template<class T = std::chrono::high_resolution_clock>
+class timer {
+public:
+    timer()
+       : start(T::now()) { }
+    double operator()() const {
+        return std::chrono::duration<double, std::milli>(T::now() - start).count();
+    }
+private:
+    typename T::time_point start;
+};
+
+template<class P, class M, class D>
+void benchmark(char const * name, M make, D data)
+{
+    boost::node_proxy x(__FILE__, BOOST_CURRENT_FUNCTION, __LINE__);
+    std::vector<P> v;
+    v.reserve(count);
+
+    timer<> allocation;
+    for (std::size_t i = 0; i < count; ++ i)
+        v.push_back(make(x));
+    double const a = allocation();
+
+    timer<> iteration;
+    long sum = 0;
+    for (std::size_t j = 0; j < passes; ++ j)
+        for (P & p : v) {
+            int const * q = data(p);
+            for (std::size_t k = 0; k < length; ++ k)
+                sum += q[k];
+        }
+    double const i = iteration();
+
+    std::cout << name << ": allocation " << a << " ms, iteration " << i << " ms (" << sum << ")" << std::endl;
+}
+
+int main()
+{
+    benchmark<boost::root_ptr<int[]>>("node<int[]>", [] (boost::node_proxy const & x) {
+        return boost::make_root<int[]>(x, length, 1);
+    }, [] (boost::root_ptr<int[]> & p) -> int const * {
+        return p;
+    });
+
+    benchmark<boost::root_ptr<int>>("node<std::vector<int>>", [] (boost::node_proxy const & x) {
+        return boost::root_ptr<int>(x, boost::make_node<std::vector<int>>(std::vector<int>(length, 1)));
+    }, [] (boost::root_ptr<int> & p) -> int const * {
+        return p;
+    });
+}
@@ -22,6 +22,7 @@
 #include <boost/shared_ptr.hpp>
 #include <boost/smart_ptr/root_ptr.hpp>
 #include <boost/make_shared.hpp>
+#include <boost/current_function.hpp>
 
 template<class T = std::chrono::high_resolution_clock>
 class timer {
@@ -105,17 +106,38 @@ struct shared_make_alloc_noinit {
 template<class T>
 struct root_new {
     void operator()() {
-        p.reset(new boost::fastnode<T>());
+        p = new boost::node<T>();
     }
-    boost::root_ptr<T> p;
+    boost::node_proxy x{__FILE__, BOOST_CURRENT_FUNCTION, __LINE__};
+    boost::root_ptr<T> p{x};
 };
 
 template<class T>
 struct root_make {
     void operator()() {
-        p = boost::make_node<T>();
+        p = boost::make_root<T>(x);
     }
-    boost::root_ptr<T> p;
+    boost::node_proxy x{__FILE__, BOOST_CURRENT_FUNCTION, __LINE__};
+    boost::root_ptr<T> p{x};
+};
+
+template<class T>
+struct shared_copy {
+    void operator()() {
+        q = p;
+    }
+    boost::shared_ptr<T> p = boost::make_shared<T>();
+    boost::shared_ptr<T> q;
+};
+
+template<class T>
+struct root_copy {
+    void operator()() {
+        q = p;
+    }
+    boost::node_proxy x{__FILE__, BOOST_CURRENT_FUNCTION, __LINE__};
+    boost::root_ptr<T> p = boost::make_root<T>(x);
+    boost::root_ptr<T> q{x};
 };
 
 int main()
@@ -132,7 +154,11 @@ int main()
         << benchmark<shared_make_alloc_noinit<int> >()
         << "\nroot_ptr (new): "
         << benchmark<root_new<int> >()
-        //<< "\nroot_ptr (make_node): "
-        //<< benchmark<root_make<int> >()
+        << "\nroot_ptr (make_root): "
+        << benchmark<root_make<int> >()
+        << "\nshared_ptr (copy): "
+        << benchmark<shared_copy<int> >()
+        << "\nroot_ptr (copy): "
+        << benchmark<root_copy<int> >()
         << std::endl;
 }
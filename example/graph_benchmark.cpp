@@ -0,0 +1,76 @@
+/**
+    @file
+    graph_benchmark.cpp
+
+    @note
+    Construction of a graph of 1M nodes, one node at a time versus all at once.
+
+    Distributed under the Boost Software License, Version 1.0.
+
+    See accompanying file LICENSE_1_0.txt or copy at
+    http://www.boost.org/LICENSE_1_0.txt
+*/
+
+#include <chrono>
+#include <vector>
+#include <iostream>
+#include <boost/smart_ptr/root_ptr.hpp>
+#include <boost/current_function.hpp>
+
+constexpr std::size_t count = 1000000;
+
+struct vertex {
+    vertex(boost::node_proxy const & x) : next(x), prior(x) { }
+    boost::root_ptr<vertex> next;
+    boost::root_ptr<vertex> prior;
+};
+
+template<class T = std::chrono::high_resolution_clock>
+class timer {
+public:
+    timer()
+       : start(T::now()) { }
+    double operator()() const {
+        return std::chrono::duration<double, std::milli>(T::now() - start).count();
+    }
+private:
+    typename T::time_point start;
+};
+
+void link(std::vector<boost::root_ptr<vertex> > & v)
+{
+    for (std::size_t i = 0; i < v.size(); ++ i) {
+        v[i]->next = v[(i + 1) % v.size()];
+        v[i]->prior = v[(i + v.size() - 1) % v.size()];
+    }
+}
+
+template<class F>
+void benchmark(char const * name, F make)
+{
+    timer<> total;
+    {
+        boost::node_proxy x(__FILE__, BOOST_CURRENT_FUNCTION, __LINE__);
+        timer<> watch;
+        std::vector<boost::root_ptr<vertex> > v = make(x);
+        double const construction = watch();
+        link(v);
+        std::cout << name << ": construction " << construction << " ms, ";
+    }
+    std::cout << "total " << total() << " ms" << std::endl;
+}
+
+int main()
+{
+    benchmark("make_root", [] (boost::node_proxy const & x) {
+        std::vector<boost::root_ptr<vertex> > v;
+        v.reserve(count);
+        for (std::size_t i = 0; i < count; ++ i)
+            v.push_back(boost::make_root<vertex>(x, x));
+        return v;
+    });
+
+    benchmark("make_nodes", [] (boost::node_proxy const & x) {
+        return boost::make_nodes<vertex>(x, count, x);
+    });
+}
@@ -0,0 +1,86 @@
+/**
+    @file
+    hugepage_benchmark.cpp
+
+    @note
+    Pointer chasing over a large graph held by a region with and without huge pages.
+
+    Build with -DBOOST_SMART_PTR_HUGE_PAGES to back the slab pools with huge pages as well.
+
+    Distributed under the Boost Software License, Version 1.0.
+
+    See accompanying file LICENSE_1_0.txt or copy at
+    http://www.boost.org/LICENSE_1_0.txt
+*/
+
+#include <chrono>
+#include <random>
+#include <vector>
+#include <numeric>
+#include <iostream>
+#include <algorithm>
+#include <boost/smart_ptr/root_ptr.hpp>
+#include <boost/smart_ptr/region_allocator.hpp>
+#include <boost/current_function.hpp>
+
+constexpr std::size_t count = 2000000;
+constexpr std::size_t steps = 20000000;
+
+struct vertex {
+    vertex(boost::node_proxy const & x) : next(x) { }
+    boost::root_ptr<vertex> next;
+    long value = 1;
+};
+
+template<class T = std::chrono::high_resolution_clock>
+class timer {
+public:
+    timer()
+       : start(T::now()) { }
+    double operator()() const {
+        return std::chrono::duration<double, std::milli>(T::now() - start).count();
+    }
+private:
+    typename T::time_point start;
+};
+
+void benchmark(char const * name, bool huge)
+{
+    boost::node_proxy x(__FILE__, BOOST_CURRENT_FUNCTION, __LINE__);
+    x.huge_pages(huge);
+
+    std::vector<boost::root_ptr<vertex> > v;
+    v.reserve(count);
+    for (std::size_t i = 0; i < count; ++ i)
+        v.push_back(boost::allocate_root<vertex>(x, boost::region_allocator<vertex>(x), x));
+
+    // a single cycle visiting the vertices in random order
+    std::vector<std::size_t> order(count);
+    std::iota(order.begin(), order.end(), 0);
+    std::shuffle(order.begin(), order.end(), std::mt19937(42));
+    for (std::size_t i = 0; i < count; ++ i)
+        v[order[i]]->next = v[order[(i + 1) % count]];
+
+    vertex * p = v[order[0]];
+    long sum = 0;
+
+    timer<> traversal;
+    for (std::size_t i = 0; i < steps; ++ i) {
+        sum += p->value;
+        p = p->next;
+    }
+    double const t = traversal();
+
+    timer<> reset;
+    v.clear();
+    x.reset();
+    double const r = reset();
+
+    std::cout << name << ": traversal " << t << " ms (" << t * 1e6 / steps << " ns/step), reset " << r << " ms (" << sum << ")" << std::endl;
+}
+
+int main()
+{
+    benchmark("4 KiB pages", false);
+    benchmark("huge pages", true);
+}
@@ -0,0 +1,35 @@
+/**
+    @file
+    trace_to_chrome.cpp
+
+    @note
+    Converts a trace written by boost::trace_file to the JSON format of Chrome tracing.
+
+    Usage: trace_to_chrome trace.bin > trace.json
+
+    Distributed under the Boost Software License, Version 1.0.
+
+    See accompanying file LICENSE_1_0.txt or copy at
+    http://www.boost.org/LICENSE_1_0.txt
+*/
+
+#include <fstream>
+#include <iostream>
+#include <boost/smart_ptr/trace.hpp>
+
+int main(int argc, char * argv[])
+{
+    if (argc != 2) {
+        std::cerr << "usage: " << argv[0] << " trace.bin > trace.json\n";
+        return 2;
+    }
+
+    std::ifstream in(argv[1], std::ios::binary);
+
+    if (! boost::chrome_trace(in, std::cout)) {
+        std::cerr << argv[1] << ": not a root_ptr trace\n";
+        return 1;
+    }
+
+    return 0;
+}
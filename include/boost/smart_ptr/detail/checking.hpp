@@ -0,0 +1,158 @@
+/**
+    \file
+    \brief Boost detail/checking.hpp header file.
+
+    Patent US11288049B2
+    'SOURCE TO SOURCE COMPILER, COMPILATION METHOD, AND
+    COMPUTER-READABLE MEDIUM FOR PREDICTABLE MEMORY MANAGEMENT'
+
+    Copyright (C) 2020-2026 Fornux LLC
+
+    Phil Bouchard, Founder & CEO
+    Fornux LLC
+    phil@fornux.com
+    3909 S Maryland Pkwy Ste 314 #638, Las Vegas, NV, 89119
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+
+#ifndef BOOST_DETAIL_CHECKING_HPP_INCLUDED
+#define BOOST_DETAIL_CHECKING_HPP_INCLUDED
+
+
+#ifndef BOOST_DISABLE_THREADS
+#include <mutex>
+#endif
+
+
+namespace boost
+{
+
+
+#ifndef BOOST_DISABLE_THREADS
+static std::recursive_mutex & static_recursive_mutex();
+#endif
+
+
+namespace checking
+{
+
+
+/**
+    Checking policy of @c root_ptr and @c root_array .
+
+    Given as their last template parameter so that unchecked and checked pointers can live in the 
+    same binary.  Pointers of different policies convert to one another.
+
+    @tparam Nulls   Dereferencing a null pointer, offsetting it or failing a cast throws a 
+                    @c root_error .
+    @tparam Bounds  Indexing out of an array throws a @c root_error .
+    @tparam Audit   Use after free, accesses out of the pointee object and leaks are recorded by 
+                    the @c reporter .
+    @tparam Locks   Dereference and pointer arithmetic are serialized by the global mutex.
+*/
+
+template <bool Nulls, bool Bounds, bool Audit, bool Locks>
+    struct policy
+    {
+        static constexpr bool nulls = Nulls;
+        static constexpr bool bounds = Bounds;
+        static constexpr bool audit = Audit;
+        static constexpr bool locks = Locks;
+    };
+
+
+/**
+    No check: dereference is a bare load, as with a raw pointer, and the caller takes care of the 
+    synchronization.
+*/
+
+typedef policy<false, false, false, false> unchecked;
+
+/** Null pointers and failed casts only. */
+typedef policy<true, false, false, true> null_only;
+
+/** Null pointers, failed casts and bounds. */
+typedef policy<true, true, false, true> full;
+
+/** All checks, with the reports of the checked build. */
+typedef policy<true, true, true, true> audit;
+
+
+/**
+    Policy of @c root_ptr and @c root_array when none is given.
+
+    Follows the legacy macros: checks throw unless @c BOOST_NO_EXCEPTIONS is defined and reports are 
+    recorded if @c BOOST_REPORT is defined.
+*/
+
+typedef policy<
+#ifndef BOOST_NO_EXCEPTIONS
+    true, true,
+#else
+    false, false,
+#endif
+#ifdef BOOST_REPORT
+    true,
+#else
+    false,
+#endif
+    true> by_default;
+
+
+} // namespace checking
+
+
+namespace smart_ptr
+{
+
+namespace detail
+{
+
+
+/**
+    Lock of the global mutex taken by a checked operation, or nothing for the unchecked policy.
+*/
+
+template <bool Locks>
+    struct check_lock
+    {
+        /** User-provided, so that an unused guard does not warn. */
+        check_lock()
+        {
+        }
+    };
+
+#ifndef BOOST_DISABLE_THREADS
+template <>
+    struct check_lock<true>
+    {
+        check_lock()
+        : guard_(static_recursive_mutex())
+        {
+        }
+
+        std::scoped_lock<std::recursive_mutex> guard_;
+    };
+#endif
+
+
+} // namespace detail
+
+} // namespace smart_ptr
+
+} // namespace boost
+
+
+#endif // #ifndef BOOST_DETAIL_CHECKING_HPP_INCLUDED
@@ -0,0 +1,326 @@
+/**
+    \file
+    \brief Boost detail/counters.hpp header file.
+
+    Patent US11288049B2
+    'SOURCE TO SOURCE COMPILER, COMPILATION METHOD, AND
+    COMPUTER-READABLE MEDIUM FOR PREDICTABLE MEMORY MANAGEMENT'
+
+    Copyright (C) 2020-2026 Fornux LLC
+
+    Phil Bouchard, Founder & CEO
+    Fornux LLC
+    phil@fornux.com
+    3909 S Maryland Pkwy Ste 314 #638, Las Vegas, NV, 89119
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+
+#ifndef BOOST_DETAIL_COUNTERS_HPP_INCLUDED
+#define BOOST_DETAIL_COUNTERS_HPP_INCLUDED
+
+
+#include <new>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include <boost/config.hpp>
+
+#ifndef BOOST_DISABLE_THREADS
+#include <mutex>
+#endif
+
+#ifdef BOOST_SMART_PTR_TRACE
+#include <boost/smart_ptr/detail/tracer.hpp>
+#endif
+
+
+namespace boost
+{
+
+namespace smart_ptr
+{
+
+namespace detail
+{
+
+
+/**
+    Event counted.
+*/
+
+enum class counter : unsigned char
+{
+    allocations,
+    frees,
+    allocated_bytes,
+    freed_bytes,
+    proxies_created,
+    proxies_destroyed,
+
+    /** References copied. */
+    copies,
+
+    /** Acquisitions of the global mutex, recursive ones included. */
+    locks
+};
+
+/** Number of counters. */
+constexpr std::size_t counters = std::size_t(counter::locks) + 1;
+
+
+/**
+    Counters of a thread, alone on their cache lines.
+
+    Only written by the thread owning the slot, thus without atomic read-modify-write, and summed
+    by the readers.  Slots are recycled once their thread exits, their values kept.
+*/
+
+struct alignas(64) counter_slot
+{
+    std::atomic<std::uint64_t> values_[counters] = {};
+
+    /** Written by several threads, thus atomically. */
+    bool shared_ = false;
+
+    /** Owned by a thread. */
+    bool used_ = false;
+
+    /** Next slot of all slots. */
+    counter_slot * next_ = nullptr;
+};
+
+
+/**
+    Slots of all threads.
+*/
+
+class counter_registry
+{
+public:
+    /** Never destroyed, so that counting works in static destructors. */
+    static counter_registry & instance()
+    {
+        static counter_registry & r = * new counter_registry;
+
+        return r;
+    }
+
+
+    /** Slot of the calling thread. */
+    static counter_slot * local()
+    {
+        if (BOOST_LIKELY(local_ != nullptr))
+            return local_;
+
+        return claim();
+    }
+
+
+    /**
+        Sums the counters of all slots.
+
+        @param  v   Receives each sum.
+    */
+
+    void sum(std::uint64_t (& v)[counters])
+    {
+#ifndef BOOST_DISABLE_THREADS
+        std::scoped_lock guard(mutex_);
+#endif
+
+        for (std::size_t i = 0; i < counters; ++ i)
+            v[i] = late_.values_[i].load(std::memory_order_relaxed);
+
+        for (counter_slot * p = slots_; p; p = p->next_)
+            for (std::size_t i = 0; i < counters; ++ i)
+                v[i] += p->values_[i].load(std::memory_order_relaxed);
+    }
+
+private:
+    counter_registry()
+    {
+        late_.shared_ = true;
+    }
+
+
+    /** Gives a slot to the calling thread, kept out of line so that counting inlines. */
+    BOOST_NOINLINE static counter_slot * claim()
+    {
+        struct holder
+        {
+            ~holder()
+            {
+                counter_registry & r = instance();
+
+#ifndef BOOST_DISABLE_THREADS
+                std::scoped_lock guard(r.mutex_);
+#endif
+
+                local_->used_ = false;
+
+                // from destructors of thread locals destroyed later on
+                local_ = & r.late_;
+            }
+        };
+
+        counter_registry & r = instance();
+
+        {
+#ifndef BOOST_DISABLE_THREADS
+            std::scoped_lock guard(r.mutex_);
+#endif
+
+            counter_slot * p = r.slots_;
+
+            while (p && p->used_)
+                p = p->next_;
+
+            if (! p)
+            {
+                // counting never throws
+                if (! (p = new (std::nothrow) counter_slot))
+                    return & r.late_;
+
+                p->next_ = r.slots_;
+                r.slots_ = p;
+            }
+
+            p->used_ = true;
+            local_ = p;
+        }
+
+        static thread_local holder h;
+
+        return local_;
+    }
+
+
+    static inline thread_local counter_slot * local_ = nullptr;
+
+    /** Slots of all threads that ever counted. */
+    counter_slot * slots_ = nullptr;
+
+    /** Slot of the threads whose own slot was recycled. */
+    counter_slot late_;
+
+#ifndef BOOST_DISABLE_THREADS
+    std::mutex mutex_;
+#endif
+};
+
+/**
+    Counts events on the calling thread.
+*/
+
+inline void count(counter k, std::uint64_t n = 1) noexcept
+{
+    counter_slot * p = counter_registry::local();
+    std::atomic<std::uint64_t> & v = p->values_[std::size_t(k)];
+
+    if (BOOST_LIKELY(! p->shared_))
+        v.store(v.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    else
+        v.fetch_add(n, std::memory_order_relaxed);
+}
+
+
+/**
+    Accounts for a node allocated.
+
+    @param  p   Address of the node.
+    @param  n   Bytes taken from the allocator.
+*/
+
+inline void allocated(void const * p, std::size_t n) noexcept
+{
+    count(counter::allocations);
+    count(counter::allocated_bytes, n);
+
+#ifdef BOOST_SMART_PTR_TRACE
+    tracer::trace(trace_kind::allocate, p, n);
+#else
+    (void) p;
+#endif
+}
+
+
+/**
+    Accounts for a node deallocated.
+
+    @param  p   Address of the node.
+    @param  n   Bytes returned to the allocator.
+*/
+
+inline void deallocated(void const * p, std::size_t n) noexcept
+{
+    count(counter::frees);
+    count(counter::freed_bytes, n);
+
+#ifdef BOOST_SMART_PTR_TRACE
+    tracer::trace(trace_kind::free, p, n);
+#else
+    (void) p;
+#endif
+}
+
+
+/**
+    Accounts for a reference copied.
+
+    @param  p   Node referenced.
+*/
+
+inline void copied(void const * p) noexcept
+{
+    count(counter::copies);
+
+#ifdef BOOST_SMART_PTR_TRACE
+    tracer::trace(trace_kind::share, p);
+#else
+    (void) p;
+#endif
+}
+
+
+/**
+    Accounts for a @c node_proxy constructed or destructed.
+
+    @param  p   The @c node_proxy .
+    @param  d   Its depth.
+    @param  b   Whether it is constructed.
+*/
+
+inline void proxy_lifetime(void const * p, std::size_t d, bool b) noexcept
+{
+    count(b ? counter::proxies_created : counter::proxies_destroyed);
+
+#ifdef BOOST_SMART_PTR_TRACE
+    tracer::trace(b ? trace_kind::proxy_construct : trace_kind::proxy_destruct, p, d);
+#else
+    (void) p;
+    (void) d;
+#endif
+}
+
+
+} // namespace detail
+
+} // namespace smart_ptr
+
+} // namespace boost
+
+
+#endif // #ifndef BOOST_DETAIL_COUNTERS_HPP_INCLUDED
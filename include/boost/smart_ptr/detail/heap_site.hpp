@@ -0,0 +1,166 @@
+/**
+    \file
+    \brief Boost detail/heap_site.hpp header file.
+
+    Patent US11288049B2
+    'SOURCE TO SOURCE COMPILER, COMPILATION METHOD, AND
+    COMPUTER-READABLE MEDIUM FOR PREDICTABLE MEMORY MANAGEMENT'
+
+    Copyright (C) 2020-2026 Fornux LLC
+
+    Phil Bouchard, Founder & CEO
+    Fornux LLC
+    phil@fornux.com
+    3909 S Maryland Pkwy Ste 314 #638, Las Vegas, NV, 89119
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+
+#ifndef BOOST_DETAIL_HEAP_SITE_HPP_INCLUDED
+#define BOOST_DETAIL_HEAP_SITE_HPP_INCLUDED
+
+
+#include <map>
+#include <tuple>
+#include <atomic>
+#include <cstddef>
+
+#ifndef BOOST_DISABLE_THREADS
+#include <mutex>
+#endif
+
+
+namespace boost
+{
+
+
+#ifndef BOOST_DISABLE_THREADS
+static std::recursive_mutex & static_recursive_mutex();
+#endif
+
+
+namespace smart_ptr
+{
+
+namespace detail
+{
+
+
+/**
+    Call site of a @c node_proxy within the chain of its parents, with the nodes it allocated that 
+    are still alive.
+
+    Sites are interned once and never destroyed, so that nodes may outlive their @c node_proxy .
+*/
+
+struct heap_site
+{
+    heap_site const * const parent_;
+    char const * const file_;
+    char const * const function_;
+    unsigned const line_;
+
+    /** Live nodes. */
+    std::atomic<std::size_t> count_{0};
+
+    /** Live bytes. */
+    std::atomic<std::size_t> bytes_{0};
+
+    /** Next site of all sites. */
+    heap_site * next_ = nullptr;
+
+
+    heap_site(heap_site const * parent, char const * file, char const * function, unsigned line)
+    : parent_(parent)
+    , file_(file)
+    , function_(function)
+    , line_(line)
+    {
+    }
+
+
+    /**
+        Site of a @c node_proxy , created on first use.
+    */
+
+    static heap_site * intern(heap_site const * parent, char const * file, char const * function, unsigned line)
+    {
+        typedef std::tuple<heap_site const *, char const *, char const *, unsigned> key;
+
+#ifndef BOOST_DISABLE_THREADS
+        std::scoped_lock guard(static_recursive_mutex());
+#endif
+
+        // leaked on purpose: used until the last node is gone
+        static std::map<key, heap_site *> & sites = * new std::map<key, heap_site *>;
+
+        heap_site * & p = sites[key(parent, file, function, line)];
+
+        if (! p)
+        {
+            p = new heap_site(parent, file, function, line);
+            p->next_ = head();
+            head() = p;
+        }
+
+        return p;
+    }
+
+
+    /**
+        Calls @c f with each site, under the global mutex.
+    */
+
+    template <typename F>
+        static void for_each(F f)
+        {
+#ifndef BOOST_DISABLE_THREADS
+            std::scoped_lock guard(static_recursive_mutex());
+#endif
+
+            for (heap_site * p = head(); p; p = p->next_)
+                f(* p);
+        }
+
+
+    void add(std::size_t n)
+    {
+        count_.fetch_add(1, std::memory_order_relaxed);
+        bytes_.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    void remove(std::size_t n)
+    {
+        count_.fetch_sub(1, std::memory_order_relaxed);
+        bytes_.fetch_sub(n, std::memory_order_relaxed);
+    }
+
+private:
+    static heap_site * & head()
+    {
+        static heap_site * p = nullptr;
+
+        return p;
+    }
+};
+
+
+} // namespace detail
+
+} // namespace smart_ptr
+
+} // namespace boost
+
+
+#endif // #ifndef BOOST_DETAIL_HEAP_SITE_HPP_INCLUDED
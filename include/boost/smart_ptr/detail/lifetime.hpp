@@ -0,0 +1,221 @@
+/**
+    \file
+    \brief Boost detail/lifetime.hpp header file.
+
+    Patent US11288049B2
+    'SOURCE TO SOURCE COMPILER, COMPILATION METHOD, AND
+    COMPUTER-READABLE MEDIUM FOR PREDICTABLE MEMORY MANAGEMENT'
+
+    Copyright (C) 2020-2026 Fornux LLC
+
+    Phil Bouchard, Founder & CEO
+    Fornux LLC
+    phil@fornux.com
+    3909 S Maryland Pkwy Ste 314 #638, Las Vegas, NV, 89119
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+
+#ifndef BOOST_DETAIL_LIFETIME_HPP_INCLUDED
+#define BOOST_DETAIL_LIFETIME_HPP_INCLUDED
+
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+#include <typeinfo>
+#include <typeindex>
+#include <unordered_map>
+
+#ifndef BOOST_DISABLE_THREADS
+#include <mutex>
+#endif
+
+
+namespace boost
+{
+
+
+/**
+    How a node was reclaimed.
+*/
+
+enum class lifetime_end : unsigned char
+{
+    /** Its last reference was released. */
+    refcount,
+
+    /** By @c node_proxy::reset() , with the rest of the @c node_proxy . */
+    reset
+};
+
+
+namespace smart_ptr
+{
+
+namespace detail
+{
+
+
+/**
+    Allocation clock: number of nodes constructed so far.
+
+    @param  b   Whether a node is being constructed.
+*/
+
+inline std::uint64_t allocation_tick(bool b) noexcept
+{
+    static std::atomic<std::uint64_t> t{0};
+
+    return b ? t.fetch_add(1, std::memory_order_relaxed) + 1 : t.load(std::memory_order_relaxed);
+}
+
+
+/**
+    Wall clock of the lifetimes, in nanoseconds.
+*/
+
+inline std::uint64_t lifetime_clock() noexcept
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+/**
+    Lifetimes of the nodes of a type, in log-scale buckets: bucket @c k holds the values @c v such 
+    that @c 2^(k-1) <= v < 2^k , bucket 0 holding 0.
+*/
+
+struct lifetime_histogram
+{
+    enum
+    {
+        buckets = 65
+    };
+
+
+    static std::size_t bucket(std::uint64_t v) noexcept
+    {
+        std::size_t k = 0;
+
+        for (; v; v >>= 1)
+            ++ k;
+
+        return k;
+    }
+
+    void record(lifetime_end e, std::uint64_t t, std::uint64_t n) noexcept
+    {
+        std::size_t const i = std::size_t(e);
+
+        ticks_[i][bucket(t)].fetch_add(1, std::memory_order_relaxed);
+        nanos_[i][bucket(n)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+
+    /** Type of the nodes. */
+    std::type_index type_;
+
+    /** Allocation ticks by reclamation. */
+    std::atomic<std::uint64_t> ticks_[2][buckets] = {};
+
+    /** Nanoseconds by reclamation. */
+    std::atomic<std::uint64_t> nanos_[2][buckets] = {};
+};
+
+
+/**
+    Histograms of all node types.
+*/
+
+class lifetime_registry
+{
+public:
+    /** Never destroyed, so that nodes reclaimed by static destructors are still recorded. */
+    static lifetime_registry & instance()
+    {
+        static lifetime_registry & r = * new lifetime_registry;
+
+        return r;
+    }
+
+
+    /**
+        Histogram of a type, created the first time.
+    */
+
+    static lifetime_histogram & of(std::type_info const & t)
+    {
+        // nodes of a same type tend to be reclaimed in a row
+        static thread_local std::type_info const * last = nullptr;
+        static thread_local lifetime_histogram * h = nullptr;
+
+        if (last == & t)
+            return * h;
+
+        lifetime_registry & r = instance();
+
+#ifndef BOOST_DISABLE_THREADS
+        std::scoped_lock guard(r.mutex_);
+#endif
+
+        std::unique_ptr<lifetime_histogram> & p = r.histograms_[std::type_index(t)];
+
+        if (! p)
+            p.reset(new lifetime_histogram{std::type_index(t)});
+
+        last = & t;
+        h = p.get();
+
+        return * h;
+    }
+
+
+    /**
+        Calls @c f with each histogram.
+    */
+
+    template <typename F>
+        void for_each(F f)
+        {
+#ifndef BOOST_DISABLE_THREADS
+            std::scoped_lock guard(mutex_);
+#endif
+
+            for (auto const & i : histograms_)
+                f(* i.second);
+        }
+
+private:
+    lifetime_registry() = default;
+
+
+    std::unordered_map<std::type_index, std::unique_ptr<lifetime_histogram>> histograms_;
+
+#ifndef BOOST_DISABLE_THREADS
+    std::mutex mutex_;
+#endif
+};
+
+
+} // namespace detail
+
+} // namespace smart_ptr
+
+} // namespace boost
+
+
+#endif // #ifndef BOOST_DETAIL_LIFETIME_HPP_INCLUDED
@@ -36,11 +36,18 @@
 # pragma once
 #endif
 
+#include <new>
+#include <atomic>
+#include <memory>
+#include <array>
+#include <vector>
 #include <cstring>
 #include <limits>
 #include <utility>
 #include <iterator>
+#include <algorithm>
 #include <type_traits>
+#include <memory_resource>
 
 #ifndef BOOST_DISABLE_THREADS
 #include <mutex>
@@ -48,26 +55,42 @@
 #include <boost/thread/tss.hpp>
 #include <boost/thread/thread.hpp>
 #include <boost/thread/recursive_mutex.hpp>
-#else
-#include <memory>
 #endif
 #include <boost/pool/pool.hpp>
 #include <boost/pool/pool_alloc.hpp>
 #include <boost/numeric/interval.hpp>
 #include <boost/type_traits/is_array.hpp>
 #include <boost/type_traits/remove_extent.hpp>
+#include <boost/type_traits/is_unbounded_array.hpp>
 #include <boost/type_traits/has_trivial_destructor.hpp>
-#include <boost/smart_ptr/detail/sp_counted_base.hpp>
-#include <boost/preprocessor/control/expr_if.hpp>
-#include <boost/preprocessor/arithmetic/inc.hpp>
-#include <boost/preprocessor/punctuation/comma_if.hpp>
-#include <boost/preprocessor/repetition/repeat.hpp>
-#include <boost/preprocessor/repetition/repeat_from_to.hpp>
+#include <boost/core/no_exceptions_support.hpp>
+#include <boost/smart_ptr/detail/sp_noexcept.hpp>
 #include <boost/concept_check.hpp>
 #include <boost/container/allocator_traits.hpp>
 #include <boost/tti/has_static_member_function.hpp>
 
+#include <boost/smart_ptr/detail/checking.hpp>
 #include <boost/smart_ptr/detail/intrusive_list.hpp>
+#include <boost/smart_ptr/detail/zeroize.hpp>
+#include <boost/smart_ptr/detail/counters.hpp>
+#include <boost/smart_ptr/slab_allocator.hpp>
+#include <boost/smart_ptr/memory_quota.hpp>
+
+#ifdef BOOST_SMART_PTR_HEAP_PROFILE
+#include <boost/smart_ptr/detail/heap_site.hpp>
+#endif
+
+#ifdef BOOST_SMART_PTR_LIFETIME
+#include <boost/smart_ptr/detail/lifetime.hpp>
+#endif
+
+#ifdef BOOST_SMART_PTR_QUARANTINE
+#include <boost/smart_ptr/detail/quarantine.hpp>
+#endif
+
+#ifdef BOOST_SMART_PTR_HANDLES
+#include <boost/smart_ptr/detail/slot_table.hpp>
+#endif
 
 
 namespace boost
@@ -82,26 +105,188 @@ static std::recursive_mutex & static_recursive_mutex();
 #endif
 
 
-template <typename T>
+template <typename T, typename C = checking::by_default>
     class root_ptr;
     
-template <typename T, size_t S>
+template <typename T, size_t S, typename C = checking::by_default>
     class root_array;
 
 
+struct node_base;
+
+
+#ifndef BOOST_DISABLE_THREADS
+/**
+    Owner thread of biased reference counts.
+
+    Each thread creating a @c node_base gets one of these.  Other threads push here the nodes whose 
+    shared counter dropped below zero so that the owner thread can merge its own counter with it.
+    
+    @note Outlives its thread until the last node biased towards it is gone.
+*/
+
+struct biased_owner
+{
+    /** Nodes biased towards this owner, plus one while the thread is alive. */
+    std::atomic<long> users_{1};
+
+    /** Set when @c queue_ is not empty. */
+    std::atomic<bool> pending_{false};
+
+    /** Set once the owner thread has exited. */
+    bool orphaned_ = false;
+
+    /** Nodes waiting for an explicit merge. */
+    std::vector<node_base *> queue_;
+
+
+    /**
+        Owner of the calling thread.
+    */
+
+    static biased_owner * current()
+    {
+        biased_owner * & p = slot();
+
+        if (! p)
+            p = make();
+
+        return p;
+    }
+
+    void push(node_base * p);
+
+    void erase(node_base * p);
+
+    void drain();
+
+    void unref()
+    {
+        if (users_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            delete this;
+    }
+
+private:
+    static biased_owner * & slot()
+    {
+        static thread_local biased_owner * p = nullptr;
+
+        return p;
+    }
+
+    static biased_owner * make();
+
+    static biased_owner * exited();
+};
+#endif
+
+
 /**
     Root class of all pointee objects.
+    
+    Reference counts are biased towards the thread that created the node: that thread uses a plain 
+    counter and all others an atomic one.  Both counters are merged once the owner thread releases 
+    its last reference, after which all threads use the atomic counter.  Only the destruction of 
+    the node takes the global mutex.
 */
 
-struct node_base : public boost::detail::sp_counted_base
+struct node_base
 {
 #ifdef BOOST_REPORT
     bool explicit_delete_ = false;
 #endif
 
+#ifndef BOOST_DISABLE_THREADS
+    /** Flags of @c shared_ . */
+    enum { merged = 1, queued = 2, unit = 4 };
+
+    /** Thread the node is biased towards. */
+    biased_owner * const owner_;
+
+    /** References held by the owner thread. */
+    long biased_;
+
+    /** References held by other threads in multiples of @c unit , and flags. */
+    std::atomic<long> shared_;
+
+    /** Quota the memory of the node is charged to. */
+    memory_quota * quota_;
+
+#ifdef BOOST_SMART_PTR_HEAP_PROFILE
+    /** Call site of the @c node_proxy the node was allocated for. */
+    smart_ptr::detail::heap_site * site_;
+#endif
+
+#ifdef BOOST_SMART_PTR_LIFETIME
+    /** Allocation tick and time the node was constructed at. */
+    std::uint64_t tick_;
+    std::uint64_t time_;
+#endif
+
+#ifdef BOOST_SMART_PTR_HANDLES
+    /** Slot designating the node to @c root_handle , or 0 if none was taken. */
+    std::uint32_t slot_;
+#endif
+
+
+    node_base()
+    : owner_(biased_owner::current())
+    , biased_(owner_->orphaned_ ? 0 : 1)
+    , shared_(owner_->orphaned_ ? unit | merged : 0)
+    , quota_(nullptr)
+#ifdef BOOST_SMART_PTR_HEAP_PROFILE
+    , site_(nullptr)
+#endif
+#ifdef BOOST_SMART_PTR_LIFETIME
+    , tick_(smart_ptr::detail::allocation_tick(true))
+    , time_(smart_ptr::detail::lifetime_clock())
+#endif
+#ifdef BOOST_SMART_PTR_HANDLES
+    , slot_(0)
+#endif
+    {
+        owner_->users_.fetch_add(1, std::memory_order_relaxed);
+    }
+#else
+    /** References. */
+    long biased_;
+
+    /** Quota the memory of the node is charged to. */
+    memory_quota * quota_;
+
+#ifdef BOOST_SMART_PTR_HEAP_PROFILE
+    /** Call site of the @c node_proxy the node was allocated for. */
+    smart_ptr::detail::heap_site * site_;
+#endif
+
+#ifdef BOOST_SMART_PTR_LIFETIME
+    /** Allocation tick and time the node was constructed at. */
+    std::uint64_t tick_;
+    std::uint64_t time_;
+#endif
+
+#ifdef BOOST_SMART_PTR_HANDLES
+    /** Slot designating the node to @c root_handle , or 0 if none was taken. */
+    std::uint32_t slot_;
+#endif
+
+
     node_base()
+    : biased_(1)
+    , quota_(nullptr)
+#ifdef BOOST_SMART_PTR_HEAP_PROFILE
+    , site_(nullptr)
+#endif
+#ifdef BOOST_SMART_PTR_LIFETIME
+    , tick_(smart_ptr::detail::allocation_tick(true))
+    , time_(smart_ptr::detail::lifetime_clock())
+#endif
+#ifdef BOOST_SMART_PTR_HANDLES
+    , slot_(0)
+#endif
     {
     }
+#endif
 
     virtual size_t size() const = 0;
 
@@ -113,6 +298,18 @@ struct node_base : public boost::detail::sp_counted_base
 
     virtual ~node_base()
     {
+#ifdef BOOST_SMART_PTR_HANDLES
+        // handles taken so far expire
+        if (slot_)
+            smart_ptr::detail::slot_table::instance().retire(slot_);
+#endif
+
+#ifndef BOOST_DISABLE_THREADS
+        if (shared_.load(std::memory_order_acquire) & queued)
+            owner_->erase(this);
+
+        owner_->unref();
+#endif
     }
 
     virtual void dispose() BOOST_SP_NOEXCEPT
@@ -123,54 +320,267 @@ struct node_base : public boost::detail::sp_counted_base
     {
         delete this;
     }
-    
-protected:
-    virtual void * get_deleter(std::type_info const &) BOOST_SP_NOEXCEPT
-    { 
-        return 0; 
+
+
+    /**
+        Adds a reference.
+    */
+
+    void add_ref_copy()
+    {
+#ifndef BOOST_DISABLE_THREADS
+        if (owned())
+            ++ biased_;
+        else
+            shared_.fetch_add(unit, std::memory_order_relaxed);
+#else
+        ++ biased_;
+#endif
     }
-    
-    virtual void * get_local_deleter(std::type_info const &) BOOST_SP_NOEXCEPT
-    { 
-        return 0; 
+
+
+    /**
+        Removes a reference and destroys the node once none are left.
+    */
+
+    void release() BOOST_SP_NOEXCEPT
+    {
+#ifndef BOOST_DISABLE_THREADS
+        if (owned() && owner_->pending_.load(std::memory_order_relaxed))
+            owner_->drain();
+
+        if (owned())
+        {
+            // implicit merge; a queued node may still be on its way to the queue so drain() reclaims it
+            if (-- biased_ == 0)
+            {
+                long const o = shared_.fetch_or(merged, std::memory_order_acq_rel);
+
+                if (! (o & queued) && o < unit)
+                    collect();
+            }
+
+            return;
+        }
+
+        long n, o = shared_.load(std::memory_order_relaxed);
+        bool queue;
+
+        do
+        {
+            n = o - unit;
+            queue = n < 0 && ! (o & (merged | queued));
+
+            if (queue)
+                n |= queued;
+        }
+        while (! shared_.compare_exchange_weak(o, n, std::memory_order_acq_rel, std::memory_order_relaxed));
+
+        if (queue)
+            owner_->push(this);
+        else if ((n & merged) && ! (n & queued) && n < unit)
+            collect();
+#else
+        if (-- biased_ == 0)
+            collect();
+#endif
     }
-    
-    virtual void * get_untyped_deleter() BOOST_SP_NOEXCEPT
-    { 
-        return 0; 
+
+
+    /**
+        Approximate reference count; exact when no other thread is sharing the node.
+    */
+
+    long use_count() const
+    {
+#ifndef BOOST_DISABLE_THREADS
+        return biased_ + shared_.load(std::memory_order_relaxed) / unit;
+#else
+        return biased_;
+#endif
     }
-};
 
 
-#define TEMPLATEARGUMENT_DECL(z, n, text) BOOST_PP_COMMA_IF(n) T ## n
-#define TEMPLATE_DECL(z, n, text) BOOST_PP_COMMA_IF(n) typename T ## n
-#define ARGUMENT_DECL(z, n, text) BOOST_PP_COMMA_IF(n) T ## n const & t ## n
-#define PARAMETER_DECL(z, n, text) BOOST_PP_COMMA_IF(n) t ## n
+#ifndef BOOST_DISABLE_THREADS
+    /**
+        Explicit merge of both counters.
+        
+        Called by the owner thread for queued nodes or by any thread once the owner has exited.
+    */
+
+    void merge() BOOST_SP_NOEXCEPT
+    {
+        long n, o = shared_.load(std::memory_order_relaxed);
+        long const b = (o & merged) ? 0 : biased_;
+
+        do
+        {
+            n = ((o & ~ queued) + b * unit) | merged;
+        }
+        while (! shared_.compare_exchange_weak(o, n, std::memory_order_acq_rel, std::memory_order_relaxed));
+
+        biased_ = 0;
+
+        if (n < unit)
+            collect();
+    }
+#endif
+
+
+#ifdef BOOST_SMART_PTR_LIFETIME
+    /**
+        Records the lifetime of the node, about to be destroyed, in the histograms of its type.
+
+        @param  e   How the node is reclaimed.
+    */
+
+    void expire(lifetime_end e) const BOOST_SP_NOEXCEPT
+    {
+        using namespace smart_ptr::detail;
+
+        lifetime_registry::of(typeid(* this)).record(e, allocation_tick(false) - tick_, lifetime_clock() - time_);
+    }
+#endif
+
+protected:
+    /**
+        Returns the memory of the node to its quota, and to its site with 
+        @c BOOST_SMART_PTR_HEAP_PROFILE .
 
-#define CONSTRUCT_NODE3(z, n, text)                                                                                             \
-    template <BOOST_PP_REPEAT(n, TEMPLATE_DECL, 0)>                                                                             \
-        text(BOOST_PP_REPEAT(n, ARGUMENT_DECL, 0)) : base(BOOST_PP_REPEAT(n, PARAMETER_DECL, 0)) {}                                                                                                        
+        @tparam A   Allocator of the node; those charging the quota by themselves are left to it.
+        @param  n   Bytes taken from the allocator.
+    */
 
-#define CONSTRUCT_NODE4(z, n, text)                                                                                             \
-    template <BOOST_PP_REPEAT(n, TEMPLATE_DECL, 0)>                                                                             \
-        text(allocator_type const & a, BOOST_PP_REPEAT(n, ARGUMENT_DECL, 0)) : base(a, BOOST_PP_REPEAT(n, PARAMETER_DECL, 0))   \
-        {                                                                                                                       \
-        }                                                                                                        
+    template <typename A>
+        void uncharge(size_t n) BOOST_SP_NOEXCEPT
+        {
+            if (quota_)
+                quota_->credit(smart_ptr::detail::charges_quota<A>::value ? 0 : n);
 
-#define ALLOCATE_NODE1(z, n, text)                                                                                              \
-    template <BOOST_PP_REPEAT(n, TEMPLATE_DECL, 0)>                                                                             \
-        static node * text(allocator_type const & a, BOOST_PP_REPEAT(n, ARGUMENT_DECL, 0))                                      \
-        {                                                                                                                       \
-            return new (a) node(a, BOOST_PP_REPEAT(n, PARAMETER_DECL, 0));                                                      \
+#ifdef BOOST_SMART_PTR_HEAP_PROFILE
+            if (site_)
+                site_->remove(n);
+#endif
         }
 
-#define MAKE_NODE_ALLOCATOR1(z, n, text)                                                                                        \
-    template<template <typename, typename...> class Alloc, typename T, BOOST_PP_REPEAT(n, TEMPLATE_DECL, 0), typename... Args>  \
-        typename node<T, Alloc<T, BOOST_PP_REPEAT(n, TEMPLATEARGUMENT_DECL, 0)> >::allocator_type text(Args&&... args)          \
-        {                                                                                                                       \
-            return typename node<T, Alloc<T, BOOST_PP_REPEAT(n, TEMPLATEARGUMENT_DECL, 0)> >::allocator_type(args...);          \
+private:
+#ifndef BOOST_DISABLE_THREADS
+    bool owned() const
+    {
+        return owner_ == biased_owner::current() && ! (shared_.load(std::memory_order_relaxed) & merged);
+    }
+#endif
+
+    void collect() BOOST_SP_NOEXCEPT
+    {
+#ifndef BOOST_DISABLE_THREADS
+        // the destructor unlinks the pointers of the pointee object from their root sets
+        std::scoped_lock guard(static_recursive_mutex());
+#endif
+
+#ifdef BOOST_SMART_PTR_LIFETIME
+        expire(lifetime_end::refcount);
+#endif
+
+        dispose();
+        destroy();
+    }
+};
+
+
+#ifndef BOOST_DISABLE_THREADS
+inline void biased_owner::push(node_base * p)
+{
+    {
+        std::scoped_lock guard(static_recursive_mutex());
+
+        if (! orphaned_)
+        {
+            queue_.push_back(p);
+            pending_.store(true, std::memory_order_release);
+
+            return;
         }
-    
+    }
+
+    p->merge();
+}
+
+
+inline void biased_owner::erase(node_base * p)
+{
+    std::scoped_lock guard(static_recursive_mutex());
+
+    queue_.erase(std::remove(queue_.begin(), queue_.end(), p), queue_.end());
+}
+
+
+inline void biased_owner::drain()
+{
+    std::vector<node_base *> q;
+
+    {
+        std::scoped_lock guard(static_recursive_mutex());
+
+        q.swap(queue_);
+        pending_.store(false, std::memory_order_relaxed);
+    }
+
+    for (node_base * p : q)
+        p->merge();
+}
+
+
+inline biased_owner * biased_owner::make()
+{
+    struct holder
+    {
+        biased_owner * p = new biased_owner;
+
+        ~holder()
+        {
+            p->drain();
+
+            std::scoped_lock guard(static_recursive_mutex());
+
+            // nodes queued from now on get merged by the thread releasing them
+            p->orphaned_ = true;
+
+            for (node_base * i : p->queue_)
+                i->merge();
+
+            p->queue_.clear();
+            p->unref();
+
+            slot() = exited();
+        }
+    };
+
+    static thread_local holder h;
+
+    return h.p;
+}
+
+
+/**
+    Owner of nodes created by a thread during its exit; these start off merged.
+*/
+
+inline biased_owner * biased_owner::exited()
+{
+    static biased_owner * p = []
+    {
+        biased_owner * p = new biased_owner;
+
+        p->orphaned_ = true;
+
+        return p;
+    }();
+
+    return p;
+}
+#endif
+
 
 /**
     Pointee object wrapper.
@@ -183,7 +593,18 @@ template <typename T>
         typedef T data_type;
 
         
-        template <typename... Args>
+        /**
+            Constructs the pointee object in place, with parentheses whenever it has a matching 
+            constructor and braces otherwise (aggregates).
+        */
+
+        template <typename... Args, typename std::enable_if<std::is_constructible<T, Args &&...>::value, int>::type = 0>
+            node_element(Args &&... args)
+            : elem_(std::forward<Args>(args)...)
+            {
+            }
+
+        template <typename... Args, typename std::enable_if<! std::is_constructible<T, Args &&...>::value, int>::type = 0>
             node_element(Args &&... args)
             : elem_{std::forward<Args>(args)...}
             {
@@ -282,62 +703,252 @@ template <typename T>
 
 
 /**
-    Pointee object & allocator wrapper.
-    
-    Main class used to instanciate pointee objects and a copy of the allocator desired.
+    Array of runtime size wrapper.
+
+    The elements are laid out by @c node<T[]> right after itself, hence the size is all it holds.
 */
 
-template <typename T, typename PoolAllocator = pool_allocator<T> >
-    class node : public node_element<T>
+template <typename T>
+    class node_element<T[]> : public node_base
     {
-        typedef node_element<T> base;
-        
     public:
         typedef T data_type;
-        typedef typename PoolAllocator::template rebind< node<T, PoolAllocator> >::other allocator_type;
 
-        
-        virtual void * element()
+
+        node_element(size_t n)
+        : size_(n)
         {
-            return reinterpret_cast<void *>(& this->base::elem_);
         }
-        
-        /**
-            Initialization of a pointee object.
-            
-            @note Will use a static copy of the allocator which has no parameter.
-        */
-        
-        node() 
-        : a_(static_pool())
+
+        virtual size_t size() const
         {
+            return size_;
         }
-        
 
-        /**
-            Initialization of a pointee object.
-            
-            @param  a   Allocator to copy.
-        */
-        
-        node(allocator_type const & a) 
-        : a_(a)
+        virtual size_t size_bytes() const
         {
+            return size_ * sizeof(T);
         }
 
 
-        template <typename... Args>
+    protected:
+        /** Number of elements. */
+        size_t size_;
+    };
+
+
+/**
+    Tells whether the first type of @c Args is @c A .
+*/
+
+template <typename A, typename... Args>
+    struct first_of : std::false_type
+    {
+    };
+
+template <typename A, typename B, typename... Args>
+    struct first_of<A, B, Args...> : std::is_same<A, typename std::decay<B>::type>
+    {
+    };
+
+
+/**
+    Tells whether chunks allocated at once by @c A can be deallocated one by one.
+*/
+
+template <typename A>
+    struct is_chunked : std::false_type
+    {
+    };
+
+template <typename T, typename UserAllocator, typename Mutex, unsigned NextSize, unsigned MaxSize>
+    struct is_chunked<pool_allocator<T, UserAllocator, Mutex, NextSize, MaxSize>> : std::true_type
+    {
+    };
+
+template <typename T, typename UserAllocator, typename Mutex, unsigned NextSize, unsigned MaxSize>
+    struct is_chunked<fast_pool_allocator<T, UserAllocator, Mutex, NextSize, MaxSize>> : std::true_type
+    {
+    };
+
+
+/**
+    Allocator of variable sized storage made of @c U given a @c PoolAllocator .
+
+    Pools only hand out chunks of a fixed size so these fall back to @c std::allocator .
+*/
+
+template <typename PoolAllocator, typename U, bool = is_chunked<PoolAllocator>::value>
+    struct storage_allocator
+    {
+        typedef typename std::allocator_traits<PoolAllocator>::template rebind_alloc<U> type;
+    };
+
+template <typename PoolAllocator, typename U>
+    struct storage_allocator<PoolAllocator, U, true>
+    {
+        typedef std::allocator<U> type;
+    };
+
+
+/**
+    User allocator of Boost pools returning blocks aligned on @c Align bytes.
+*/
+
+template <size_t Align>
+    struct aligned_user_allocator
+    {
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+
+        static char * malloc BOOST_PREVENT_MACRO_SUBSTITUTION(size_type const n)
+        {
+            return static_cast<char *>(::operator new(n, std::align_val_t(Align), std::nothrow));
+        }
+
+        static void free BOOST_PREVENT_MACRO_SUBSTITUTION(char * const p)
+        {
+            ::operator delete(p, std::align_val_t(Align));
+        }
+    };
+
+
+/**
+    Replaces the default user allocator of a Boost pool by one honoring @c Align .
+
+    Chunks are carved out of each block contiguously and their size is a multiple of the alignment 
+    of the @c node , so aligning the blocks is enough.  Other allocators are left untouched since 
+    @c std::allocator and @c std::pmr::polymorphic_allocator already honor over-alignment.
+*/
+
+template <typename UserAllocator, size_t Align>
+    struct aligned_user
+    {
+        typedef UserAllocator type;
+    };
+
+template <size_t Align>
+    struct aligned_user<default_user_allocator_new_delete, Align>
+    {
+        typedef aligned_user_allocator<Align> type;
+    };
+
+template <size_t Align>
+    struct aligned_user<default_user_allocator_malloc_free, Align>
+    {
+        typedef aligned_user_allocator<Align> type;
+    };
+
+template <typename PoolAllocator, size_t Align, bool = (Align > __STDCPP_DEFAULT_NEW_ALIGNMENT__)>
+    struct aligned_pool
+    {
+        typedef PoolAllocator type;
+    };
+
+template <typename T, typename UserAllocator, typename Mutex, unsigned NextSize, unsigned MaxSize, size_t Align>
+    struct aligned_pool<pool_allocator<T, UserAllocator, Mutex, NextSize, MaxSize>, Align, true>
+    {
+        typedef pool_allocator<T, typename aligned_user<UserAllocator, Align>::type, Mutex, NextSize, MaxSize> type;
+    };
+
+template <typename T, typename UserAllocator, typename Mutex, unsigned NextSize, unsigned MaxSize, size_t Align>
+    struct aligned_pool<fast_pool_allocator<T, UserAllocator, Mutex, NextSize, MaxSize>, Align, true>
+    {
+        typedef fast_pool_allocator<T, typename aligned_user<UserAllocator, Align>::type, Mutex, NextSize, MaxSize> type;
+    };
+
+
+/**
+    Makes room for @c n objects in the pool behind @c a ahead of time.
+
+    Pools without a way to reserve are grown by allocating and deallocating @c n objects.
+*/
+
+template <typename A>
+    inline void reserve_pool(A & a, size_t n)
+    {
+#ifndef BOOST_DISABLE_THREADS
+        std::scoped_lock guard(static_recursive_mutex());
+#endif
+
+        std::vector<typename std::allocator_traits<A>::pointer> p(n);
+
+        for (auto & i : p)
+            i = a.allocate(1);
+
+        for (auto & i : p)
+            a.deallocate(i, 1);
+    }
+
+template <typename T>
+    inline void reserve_pool(slab_allocator<T> & a, size_t n)
+    {
+        // large objects are not pooled
+        if constexpr (sizeof(T) < slab_allocator<T>::large_object)
+            a.pool().reserve(n);
+    }
+
+
+/**
+    Pointee object & allocator wrapper.
+    
+    Main class used to instanciate pointee objects and a copy of the allocator desired.
+    
+    @note The default pool is made of slabs, which are returned to the system by 
+    @c release_memory() once all their chunks are free.
+*/
+
+template <typename T, typename PoolAllocator = slab_allocator<T> >
+    class node : public node_element<T>
+    {
+        typedef node_element<T> base;
+        
+    public:
+        typedef T data_type;
+        typedef typename aligned_pool<typename std::allocator_traits<PoolAllocator>::template rebind_alloc< node<T, PoolAllocator> >, alignof(T)>::type allocator_type;
+
+        
+        virtual void * element()
+        {
+            return reinterpret_cast<void *>(& this->base::elem_);
+        }
+        
+        /**
+            Initialization of a pointee object.
+            
+            @note Will use a static copy of the allocator which has no parameter.
+        */
+        
+        node() 
+        : a_(static_pool())
+        {
+        }
+        
+
+        /**
+            Initialization of a pointee object.
+            
+            @param  a   Allocator to copy.
+        */
+        
+        node(allocator_type const & a) 
+        : a_(a)
+        {
+        }
+
+
+        template <typename... Args, typename = typename std::enable_if<! first_of<allocator_type, Args...>::value>::type>
             node(Args &&... args)
-            : a_(static_pool())
-            , node_element<T>{std::forward<Args>(args)...}
+            : node_element<T>{std::forward<Args>(args)...}
+            , a_(static_pool())
             {
             }
             
 
         template <typename... Args>
             node(allocator_type const & a, Args &&... args)
-            : a_(a)
-            , node_element<T>{std::forward<Args>(args)...}
+            : node_element<T>{std::forward<Args>(args)...}
+            , a_(a)
             {
             }
 
@@ -351,14 +962,80 @@ template <typename T, typename PoolAllocator = pool_allocator<T> >
         }
 
 
+        /**
+            Allocates storage for a series of @c node from the static pool in a single critical section.
+
+            @param  p   Receives the address of each @c node .
+            @param  n   Number of @c node .
+        */
+
+        static void allocate(node ** p, size_t n)
+        {
+#ifndef BOOST_DISABLE_THREADS
+            std::scoped_lock guard(static_recursive_mutex());
+#endif
+
+            if constexpr (is_chunked<allocator_type>::value)
+            {
+                // contiguous chunks which can be deallocated one by one
+                node * q = static_pool().allocate(n);
+
+                for (size_t i = 0; i < n; ++ i)
+                    p[i] = q + i;
+            }
+            else
+            {
+                for (size_t i = 0; i < n; ++ i)
+                    p[i] = static_pool().allocate(1);
+            }
+
+            for (size_t i = 0; i < n; ++ i)
+                smart_ptr::detail::allocated(p[i], sizeof(node));
+        }
+
+
+        /**
+            Deallocates storage of a @c node that was never constructed.
+
+            @param  p   Address of the @c node .
+        */
+
+        static void deallocate(node * p)
+        {
+            operator delete(p);
+        }
+
+
+        /**
+            Bytes taken from the allocator by a @c node .
+        */
+
+        template <typename... Args>
+            static constexpr size_t footprint(Args const &...)
+            {
+                return sizeof(node);
+            }
+
+
+        /**
+            Prepares the static pool for @c n nodes ahead of time.
+
+            @param  n   Number of @c node .
+        */
+
+        static void reserve(size_t n)
+        {
+            reserve_pool(static_pool(), n);
+        }
+
+
         /**
             Allocates a new @c node using the static copy of @c PoolAllocator to be used.
             
-            @param  s   Disregarded.
             @return     Pointer of the new @c node.
         */
 
-        void * operator new (size_t s)
+        void * operator new (size_t)
         {
 #ifndef BOOST_DISABLE_THREADS
             std::scoped_lock guard(static_recursive_mutex());
@@ -366,6 +1043,8 @@ template <typename T, typename PoolAllocator = pool_allocator<T> >
 
             void * p = static_pool().allocate(1);
 
+            smart_ptr::detail::allocated(p, sizeof(node));
+
             return p;
         }
 
@@ -373,12 +1052,11 @@ template <typename T, typename PoolAllocator = pool_allocator<T> >
         /**
             Allocates a new @c node .
             
-            @param  s   Disregarded.
             @param  a   Copy of @c PoolAllocator to be used.
             @return     Pointer of the new @c node.
         */
 
-        void * operator new (size_t s, allocator_type a)
+        void * operator new (size_t, allocator_type a)
         {
 #ifndef BOOST_DISABLE_THREADS
             std::scoped_lock guard(static_recursive_mutex());
@@ -386,6 +1064,8 @@ template <typename T, typename PoolAllocator = pool_allocator<T> >
 
             void * p = a.allocate(1);
 
+            smart_ptr::detail::allocated(p, sizeof(node));
+
             return p;
         }
 
@@ -402,7 +1082,13 @@ template <typename T, typename PoolAllocator = pool_allocator<T> >
             std::scoped_lock guard(static_recursive_mutex());
 #endif
 
-	    static_pool().deallocate(static_cast<node *>(p), 1);
+            // stateful allocators without a static pool are only released by destroy()
+            if constexpr (std::is_default_constructible<allocator_type>::value)
+            {
+                smart_ptr::detail::deallocated(p, sizeof(node));
+
+                static_pool().deallocate(static_cast<node *>(p), 1);
+            }
         }
 
 
@@ -419,23 +1105,51 @@ template <typename T, typename PoolAllocator = pool_allocator<T> >
             std::scoped_lock guard(static_recursive_mutex());
 #endif
 
+            smart_ptr::detail::deallocated(p, sizeof(node));
+
             a.deallocate(static_cast<node *>(p), 1);
         }
 
 
         virtual void destroy() BOOST_SP_NOEXCEPT
         {
-#ifdef BOOST_ZEROIZATION
+            // the allocator the node was constructed with owns its memory
+            allocator_type a(a_);
+
+            this->template uncharge<allocator_type>(sizeof(*this));
             this->~node();
-            std::memset(this, 0, sizeof(*this));
-            operator delete(this);
-#else
-            delete this;
+#ifdef BOOST_SMART_PTR_QUARANTINE
+            // only stateless allocators outlive the owner of the node; the wipe waits for the release
+            if constexpr (std::allocator_traits<allocator_type>::is_always_equal::value)
+                return smart_ptr::detail::quarantine::instance().hold(this, sizeof(*this), & release);
 #endif
+#ifdef BOOST_ZEROIZATION
+            if constexpr (! smart_ptr::detail::is_zeroizing<allocator_type>::value)
+                smart_ptr::detail::zeroize(this, sizeof(*this));
+#endif
+            operator delete(this, a);
         }
 
 
     private:
+#ifdef BOOST_SMART_PTR_QUARANTINE
+        /**
+            Returns a @c node leaving the quarantine to the static pool.
+        */
+
+        static void release(void * p, size_t n)
+        {
+#ifdef BOOST_ZEROIZATION
+            if constexpr (! smart_ptr::detail::is_zeroizing<allocator_type>::value)
+                smart_ptr::detail::zeroize(p, n);
+#else
+            (void) n;
+#endif
+            operator delete(p, static_pool());
+        }
+#endif
+
+
         /** 
             Static pool.
             
@@ -463,7 +1177,7 @@ template <typename T, size_t S, typename PoolAllocator>
 
     public:
         typedef std::array<T, S> data_type;
-        typedef typename PoolAllocator::template rebind< node<std::array<T, S>, PoolAllocator> >::other allocator_type;
+        typedef typename aligned_pool<typename std::allocator_traits<PoolAllocator>::template rebind_alloc< node<std::array<T, S>, PoolAllocator> >, alignof(T)>::type allocator_type;
 
 
         virtual void * element()
@@ -495,18 +1209,18 @@ template <typename T, size_t S, typename PoolAllocator>
             }
 
 
-        template <typename... Args>
+        template <typename... Args, typename = typename std::enable_if<! first_of<allocator_type, Args...>::value>::type>
             node(Args &&... args)
-                : a_(static_pool())
-                , node_element<data_type>{std::forward<Args>(args)...}
+                : node_element<data_type>{std::forward<Args>(args)...}
+                , a_(static_pool())
             {
             }
 
 
         template <typename... Args>
             node(allocator_type const & a, Args &&... args)
-                : a_(a)
-                , node_element<data_type>{std::forward<Args>(args)...}
+                : node_element<data_type>{std::forward<Args>(args)...}
+                , a_(a)
             {
             }
 
@@ -533,14 +1247,80 @@ template <typename T, size_t S, typename PoolAllocator>
         }
 
 
+        /**
+            Allocates storage for a series of @c node from the static pool in a single critical section.
+
+            @param  p   Receives the address of each @c node .
+            @param  n   Number of @c node .
+        */
+
+        static void allocate(node ** p, size_t n)
+        {
+#ifndef BOOST_DISABLE_THREADS
+            std::scoped_lock guard(static_recursive_mutex());
+#endif
+
+            if constexpr (is_chunked<allocator_type>::value)
+            {
+                // contiguous chunks which can be deallocated one by one
+                node * q = static_pool().allocate(n);
+
+                for (size_t i = 0; i < n; ++ i)
+                    p[i] = q + i;
+            }
+            else
+            {
+                for (size_t i = 0; i < n; ++ i)
+                    p[i] = static_pool().allocate(1);
+            }
+
+            for (size_t i = 0; i < n; ++ i)
+                smart_ptr::detail::allocated(p[i], sizeof(node));
+        }
+
+
+        /**
+            Deallocates storage of a @c node that was never constructed.
+
+            @param  p   Address of the @c node .
+        */
+
+        static void deallocate(node * p)
+        {
+            operator delete(p);
+        }
+
+
+        /**
+            Bytes taken from the allocator by a @c node .
+        */
+
+        template <typename... Args>
+            static constexpr size_t footprint(Args const &...)
+            {
+                return sizeof(node);
+            }
+
+
+        /**
+            Prepares the static pool for @c n nodes ahead of time.
+
+            @param  n   Number of @c node .
+        */
+
+        static void reserve(size_t n)
+        {
+            reserve_pool(static_pool(), n);
+        }
+
+
         /**
             Allocates a new @c node using the static copy of @c PoolAllocator to be used.
 
-            @param  s   Disregarded.
             @return     Pointer of the new @c node.
         */
 
-        void * operator new (size_t s)
+        void * operator new (size_t)
         {
 #ifndef BOOST_DISABLE_THREADS
             std::scoped_lock guard(static_recursive_mutex());
@@ -548,6 +1328,8 @@ template <typename T, size_t S, typename PoolAllocator>
 
             void * p = static_pool().allocate(1);
 
+            smart_ptr::detail::allocated(p, sizeof(node));
+
             return p;
         }
 
@@ -555,12 +1337,11 @@ template <typename T, size_t S, typename PoolAllocator>
         /**
             Allocates a new @c node .
 
-            @param  s   Disregarded.
             @param  a   Copy of @c PoolAllocator to be used.
             @return     Pointer of the new @c node.
         */
 
-        void * operator new (size_t s, allocator_type a)
+        void * operator new (size_t, allocator_type a)
         {
 #ifndef BOOST_DISABLE_THREADS
             std::scoped_lock guard(static_recursive_mutex());
@@ -568,6 +1349,8 @@ template <typename T, size_t S, typename PoolAllocator>
 
             void * p = a.allocate(1);
 
+            smart_ptr::detail::allocated(p, sizeof(node));
+
             return p;
         }
 
@@ -584,7 +1367,13 @@ template <typename T, size_t S, typename PoolAllocator>
             std::scoped_lock guard(static_recursive_mutex());
 #endif
 
-            static_pool().deallocate(static_cast<node *>(p), 1);
+            // stateful allocators without a static pool are only released by destroy()
+            if constexpr (std::is_default_constructible<allocator_type>::value)
+            {
+                smart_ptr::detail::deallocated(p, sizeof(node));
+
+                static_pool().deallocate(static_cast<node *>(p), 1);
+            }
         }
 
 
@@ -601,23 +1390,51 @@ template <typename T, size_t S, typename PoolAllocator>
             std::scoped_lock guard(static_recursive_mutex());
 #endif
 
+            smart_ptr::detail::deallocated(p, sizeof(node));
+
             a.deallocate(static_cast<node *>(p), 1);
         }
 
 
         virtual void destroy() BOOST_SP_NOEXCEPT
         {
-#ifdef BOOST_ZEROIZATION
+            // the allocator the node was constructed with owns its memory
+            allocator_type a(a_);
+
+            this->template uncharge<allocator_type>(sizeof(*this));
             this->~node();
-            std::memset(this, 0, sizeof(*this));
-            operator delete(this);
-#else
-            delete this;
+#ifdef BOOST_SMART_PTR_QUARANTINE
+            // only stateless allocators outlive the owner of the node; the wipe waits for the release
+            if constexpr (std::allocator_traits<allocator_type>::is_always_equal::value)
+                return smart_ptr::detail::quarantine::instance().hold(this, sizeof(*this), & release);
 #endif
+#ifdef BOOST_ZEROIZATION
+            if constexpr (! smart_ptr::detail::is_zeroizing<allocator_type>::value)
+                smart_ptr::detail::zeroize(this, sizeof(*this));
+#endif
+            operator delete(this, a);
         }
 
 
     private:
+#ifdef BOOST_SMART_PTR_QUARANTINE
+        /**
+            Returns a @c node leaving the quarantine to the static pool.
+        */
+
+        static void release(void * p, size_t n)
+        {
+#ifdef BOOST_ZEROIZATION
+            if constexpr (! smart_ptr::detail::is_zeroizing<allocator_type>::value)
+                smart_ptr::detail::zeroize(p, n);
+#else
+            (void) n;
+#endif
+            operator delete(p, static_pool());
+        }
+#endif
+
+
         /**
             Static pool.
 
@@ -638,6 +1455,327 @@ template <typename T, size_t S, typename PoolAllocator>
     };
 
 
+/**
+    Array of runtime size.
+
+    Elements follow the @c node in the same block of memory, thus a single allocation is needed and 
+    no indirection is involved to reach them.  Instances are created by @c make() or @c allocate() .
+*/
+
+template <typename T, typename PoolAllocator>
+    class node<T[], PoolAllocator> : public node_element<T[]>
+    {
+        typedef node_element<T[]> base;
+
+        /** Unit of storage, aligned for both the @c node and its elements. */
+        struct alignas(alignof(base) > alignof(T) ? alignof(base) : alignof(T)) unit
+        {
+            unsigned char b_[alignof(base) > alignof(T) ? alignof(base) : alignof(T)];
+        };
+
+    public:
+        typedef T data_type;
+        typedef typename storage_allocator<PoolAllocator, unit>::type allocator_type;
+
+
+        virtual void const * data()
+        {
+            return begin();
+        }
+
+        virtual void * element()
+        {
+            return begin();
+        }
+
+
+        /**
+            Destructor.
+        */
+
+        virtual ~node()
+        {
+            for (size_t i = this->size_; i > 0; -- i)
+                begin()[i - 1].~T();
+        }
+
+
+        /**
+            Allocates a new @c node using the static copy of the allocator.
+
+            @param  n       Number of elements.
+            @param  args    Arguments given to the constructor of each element.
+            @return         Pointer of the new @c node.
+        */
+
+        template <typename... Args>
+            static node * make(size_t n, Args const &... args)
+            {
+                return allocate(static_pool(), n, args...);
+            }
+
+
+        /**
+            Allocates a new @c node .
+
+            @param  a       Copy of the allocator to be used.
+            @param  n       Number of elements.
+            @param  args    Arguments given to the constructor of each element.
+            @return         Pointer of the new @c node.
+        */
+
+        template <typename... Args>
+            static node * allocate(allocator_type const & a, size_t n, Args const &... args)
+            {
+                allocator_type b(a);
+                node * p;
+
+                {
+#ifndef BOOST_DISABLE_THREADS
+                    std::scoped_lock guard(static_recursive_mutex());
+#endif
+
+                    p = ::new (static_cast<void *>(b.allocate(units(n)))) node(b);
+                }
+
+                smart_ptr::detail::allocated(p, units(n) * sizeof(unit));
+
+                BOOST_TRY
+                {
+                    // size_ only accounts for the elements constructed so far if one throws
+                    for (; p->size_ < n; ++ p->size_)
+                        ::new (static_cast<void *>(p->begin() + p->size_)) T(args...);
+                }
+                BOOST_CATCH (...)
+                {
+                    // the storage is that of n elements whatever the number built
+                    for (; p->size_ > 0; -- p->size_)
+                        p->begin()[p->size_ - 1].~T();
+
+                    p->~node();
+#ifdef BOOST_ZEROIZATION
+                    if constexpr (! smart_ptr::detail::is_zeroizing<allocator_type>::value)
+                        smart_ptr::detail::zeroize(p, units(n) * sizeof(unit));
+#endif
+
+                    {
+#ifndef BOOST_DISABLE_THREADS
+                        std::scoped_lock guard(static_recursive_mutex());
+#endif
+
+                        smart_ptr::detail::deallocated(p, units(n) * sizeof(unit));
+
+                        b.deallocate(reinterpret_cast<unit *>(p), units(n));
+                    }
+
+                    BOOST_RETHROW
+                }
+                BOOST_CATCH_END
+
+                return p;
+            }
+
+
+        /**
+            Bytes taken from the allocator by a @c node .
+
+            @param  n   Number of elements.
+        */
+
+        template <typename... Args>
+            static size_t footprint(size_t n, Args const &...)
+            {
+                return units(n) * sizeof(unit);
+            }
+
+
+        void * operator new (size_t s) = delete;
+
+
+        virtual void destroy() BOOST_SP_NOEXCEPT
+        {
+            // the allocator the node was constructed with owns its memory
+            allocator_type a(a_);
+            size_t const n = units(this->size_);
+
+            this->template uncharge<allocator_type>(n * sizeof(unit));
+            this->~node();
+#ifdef BOOST_SMART_PTR_QUARANTINE
+            // the wipe waits for the release
+            if constexpr (std::allocator_traits<allocator_type>::is_always_equal::value)
+                return smart_ptr::detail::quarantine::instance().hold(this, n * sizeof(unit), & release);
+#endif
+#ifdef BOOST_ZEROIZATION
+            if constexpr (! smart_ptr::detail::is_zeroizing<allocator_type>::value)
+                smart_ptr::detail::zeroize(this, n * sizeof(unit));
+#endif
+#ifndef BOOST_DISABLE_THREADS
+            std::scoped_lock guard(static_recursive_mutex());
+#endif
+
+            smart_ptr::detail::deallocated(this, n * sizeof(unit));
+
+            a.deallocate(reinterpret_cast<unit *>(this), n);
+        }
+
+
+    private:
+#ifdef BOOST_SMART_PTR_QUARANTINE
+        /**
+            Returns a @c node leaving the quarantine to the static pool.
+        */
+
+        static void release(void * p, size_t n)
+        {
+#ifdef BOOST_ZEROIZATION
+            if constexpr (! smart_ptr::detail::is_zeroizing<allocator_type>::value)
+                smart_ptr::detail::zeroize(p, n);
+#endif
+#ifndef BOOST_DISABLE_THREADS
+            std::scoped_lock guard(static_recursive_mutex());
+#endif
+
+            smart_ptr::detail::deallocated(p, n);
+
+            static_pool().deallocate(static_cast<unit *>(p), n / sizeof(unit));
+        }
+#endif
+
+        node(allocator_type const & a)
+        : base(0)
+        , a_(a)
+        {
+        }
+
+        /** Address of the first element. */
+        T * begin()
+        {
+            return reinterpret_cast<T *>(reinterpret_cast<unit *>(this) + units(0));
+        }
+
+        /** Units of storage needed by a @c node of @c n elements. */
+        static size_t units(size_t n)
+        {
+            return (sizeof(node) + sizeof(unit) - 1) / sizeof(unit) + (n * sizeof(T) + sizeof(unit) - 1) / sizeof(unit);
+        }
+
+        static allocator_type & static_pool()
+        {
+            static allocator_type pool_;
+
+            return pool_;
+        }
+
+
+        /** Copy of the allocator to be used. */
+        allocator_type a_;
+    };
+
+
+/**
+    Allocates a new @c node using its static pool.
+    
+    @param  args    Arguments forwarded to the constructor of the pointee object, preceded by the 
+                    number of elements for arrays of unknown bound.
+    @return         Pointer of the new @c node.
+*/
+
+template <typename T, typename... Args>
+    inline node<T> * make_node(Args &&... args)
+    {
+        if constexpr (is_unbounded_array<T>::value)
+            return node<T>::make(std::forward<Args>(args)...);
+        else
+            return new node<T>(std::forward<Args>(args)...);
+    }
+
+
+/**
+    Allocates a new @c node using a copy of the allocator given.
+    
+    @param  a       Allocator, rebound to the @c node type.
+    @param  args    Arguments forwarded to the constructor of the pointee object, preceded by the 
+                    number of elements for arrays of unknown bound.
+    @return         Pointer of the new @c node.
+*/
+
+template <typename T, typename Allocator, typename... Args>
+    inline node<T, typename std::allocator_traits<Allocator>::template rebind_alloc<T>> * allocate_node(Allocator const & a, Args &&... args)
+    {
+        typedef node<T, typename std::allocator_traits<Allocator>::template rebind_alloc<T>> node_type;
+        
+        typedef typename node_type::allocator_type allocator_type;
+
+        // pools substituted by the node are stateless
+        allocator_type b = [& a]
+        {
+            if constexpr (std::is_constructible<allocator_type, Allocator const &>::value)
+                return allocator_type(a);
+            else
+                return allocator_type();
+        }();
+
+        if constexpr (is_unbounded_array<T>::value)
+            return node_type::allocate(b, std::forward<Args>(args)...);
+        else
+            return new (b) node_type(b, std::forward<Args>(args)...);
+    }
+
+
+/**
+    Instantiates an allocator already rebound to the @c node type.
+    
+    @param  args    Arguments forwarded to the constructor of the allocator.
+*/
+
+template <template <typename, typename...> class Alloc, typename T, typename... Params, typename... Args>
+    inline typename node<T, Alloc<T, Params...>>::allocator_type make_node_allocator(Args &&... args)
+    {
+        return typename node<T, Alloc<T, Params...>>::allocator_type(std::forward<Args>(args)...);
+    }
+
+
+/**
+    Prepares the static pools of a series of @c node ahead of time.
+
+    Meant to be called at startup so the first allocations do not pay for growing the pools nor 
+    for faulting their pages in, e.g. @c prewarm<node<A>,node<B>>({1000,500}) .
+
+    @param  counts  Number of each @c node .
+*/
+
+template <typename... Nodes>
+    inline void prewarm(std::array<size_t, sizeof...(Nodes)> const & counts)
+    {
+        size_t i = 0;
+
+        (Nodes::reserve(counts[i ++]), ...);
+    }
+
+
+/**
+    Prepares the static pools of a series of @c node ahead of time.
+
+    @param  n   Number of each @c node .
+*/
+
+template <typename... Nodes>
+    inline void prewarm(size_t n)
+    {
+        (Nodes::reserve(n), ...);
+    }
+
+
+/**
+    Pointee object using a @c std::pmr::memory_resource .
+    
+    One instantiation per pointee type, whatever resource is used at runtime.
+*/
+
+template <typename T>
+    using pmr_node = node<T, std::pmr::polymorphic_allocator<T>>;
+
+
 } // namespace boost
 
 
@@ -0,0 +1,208 @@
+/**
+    \file
+    \brief Boost detail/pages.hpp header file.
+
+    Patent US11288049B2
+    'SOURCE TO SOURCE COMPILER, COMPILATION METHOD, AND
+    COMPUTER-READABLE MEDIUM FOR PREDICTABLE MEMORY MANAGEMENT'
+
+    Copyright (C) 2020-2026 Fornux LLC
+
+    Phil Bouchard, Founder & CEO
+    Fornux LLC
+    phil@fornux.com
+    3909 S Maryland Pkwy Ste 314 #638, Las Vegas, NV, 89119
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+
+#ifndef BOOST_DETAIL_PAGES_HPP_INCLUDED
+#define BOOST_DETAIL_PAGES_HPP_INCLUDED
+
+
+#include <new>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <system_error>
+
+#include <boost/throw_exception.hpp>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#define BOOST_SMART_PTR_MMAP
+#endif
+
+
+namespace boost
+{
+
+
+/**
+    Allocation beyond a fixed memory budget.
+*/
+
+class budget_exceeded : public std::bad_alloc
+{
+public:
+    char const * what() const noexcept override
+    {
+        return "memory budget exceeded";
+    }
+};
+
+
+namespace smart_ptr
+{
+
+namespace detail
+{
+
+
+enum
+{
+    /** Smallest size of a page. */
+    page_size = 4096,
+
+    /** Size of a huge page. */
+    huge_page_size = 2 * 1024 * 1024
+};
+
+
+/**
+    Maps pages of memory.
+
+    Huge pages are taken from the reserved pool (@c MAP_HUGETLB ) when possible, or else 
+    transparent huge pages are requested for the range (@c MADV_HUGEPAGE ).
+
+    @param  n       Size in bytes, a multiple of the page size.
+    @param  a       Alignment, a power of 2.
+    @param  huge    Whether to use huge pages; @c n is then a multiple of @c huge_page_size .
+    @return         Address of the pages.
+*/
+
+inline void * map_pages(std::size_t n, std::size_t a, bool huge = false)
+{
+#ifdef BOOST_SMART_PTR_MMAP
+#ifdef MAP_HUGETLB
+    if (huge && a <= huge_page_size)
+    {
+        void * p = ::mmap(nullptr, n, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+
+        if (p != MAP_FAILED)
+            return p;
+    }
+#endif
+
+    // mappings are aligned on pages already
+    if (! huge && a <= page_size)
+    {
+        void * p = ::mmap(nullptr, n, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+        if (p == MAP_FAILED)
+            boost::throw_exception(std::bad_alloc());
+
+        return p;
+    }
+
+    // transparent huge pages only back aligned ranges
+    if (huge && a < huge_page_size)
+        a = huge_page_size;
+
+    // larger by the alignment to find a boundary within
+    char * p = static_cast<char *>(::mmap(nullptr, n + a, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+
+    if (p == MAP_FAILED)
+        boost::throw_exception(std::bad_alloc());
+
+    char * q = reinterpret_cast<char *>((reinterpret_cast<std::uintptr_t>(p) + a - 1) & ~ (a - 1));
+
+    if (q != p)
+        ::munmap(p, q - p);
+
+    ::munmap(q + n, p + a - q);
+
+#ifdef MADV_HUGEPAGE
+    if (huge)
+        ::madvise(q, n, MADV_HUGEPAGE);
+#endif
+
+    return q;
+#else
+    return ::operator new(n, std::align_val_t(a));
+#endif
+}
+
+
+/**
+    Faults pages of memory in.
+
+    @param  p   Address of the pages.
+    @param  n   Size in bytes.
+*/
+
+inline void fault_pages(void * p, std::size_t n)
+{
+    for (char volatile * q = static_cast<char *>(p); q < static_cast<char *>(p) + n; q += page_size)
+        * q = * q;
+}
+
+
+/**
+    Faults pages of memory in and locks them in RAM.
+
+    @param  p   Address of the pages.
+    @param  n   Size in bytes.
+*/
+
+inline void lock_pages(void * p, std::size_t n)
+{
+#ifdef BOOST_SMART_PTR_MMAP
+    if (::mlock(p, n) != 0)
+        boost::throw_exception(std::system_error(errno, std::generic_category(), "mlock"));
+#endif
+
+    fault_pages(p, n);
+}
+
+
+/**
+    Unmaps pages of memory.
+
+    @param  p   Address of the pages.
+    @param  n   Size in bytes given to @c map_pages() .
+    @param  a   Alignment given to @c map_pages() .
+*/
+
+inline void unmap_pages(void * p, std::size_t n, std::size_t a)
+{
+#ifdef BOOST_SMART_PTR_MMAP
+    // trimmed to their size by map_pages()
+    (void) a;
+
+    ::munmap(p, n);
+#else
+    ::operator delete(p, std::align_val_t(a));
+#endif
+}
+
+
+} // namespace detail
+
+} // namespace smart_ptr
+
+} // namespace boost
+
+
+#endif // #ifndef BOOST_DETAIL_PAGES_HPP_INCLUDED
@@ -0,0 +1,293 @@
+/**
+    \file
+    \brief Boost detail/quarantine.hpp header file.
+
+    Patent US11288049B2
+    'SOURCE TO SOURCE COMPILER, COMPILATION METHOD, AND
+    COMPUTER-READABLE MEDIUM FOR PREDICTABLE MEMORY MANAGEMENT'
+
+    Copyright (C) 2020-2026 Fornux LLC
+
+    Phil Bouchard, Founder & CEO
+    Fornux LLC
+    phil@fornux.com
+    3909 S Maryland Pkwy Ste 314 #638, Las Vegas, NV, 89119
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+
+#ifndef BOOST_DETAIL_QUARANTINE_HPP_INCLUDED
+#define BOOST_DETAIL_QUARANTINE_HPP_INCLUDED
+
+
+#include <new>
+#include <limits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <boost/config.hpp>
+
+#ifndef BOOST_DISABLE_THREADS
+#include <mutex>
+#endif
+
+
+#ifndef BOOST_SMART_PTR_QUARANTINE_BYTES
+/** Default bound of the bytes held in quarantine. */
+#define BOOST_SMART_PTR_QUARANTINE_BYTES (1 << 20)
+#endif
+
+#ifndef BOOST_SMART_PTR_QUARANTINE_NODES
+/** Bound of the nodes held in quarantine, fixing the size of its FIFO. */
+#define BOOST_SMART_PTR_QUARANTINE_NODES 4096
+#endif
+
+
+namespace boost
+{
+
+
+#ifndef BOOST_DISABLE_THREADS
+static std::recursive_mutex & static_recursive_mutex();
+#endif
+
+
+namespace smart_ptr
+{
+
+namespace detail
+{
+
+
+/**
+    Quarantine of freed nodes.
+
+    The memory of a destroyed @c node is filled with a poison pattern and held in a FIFO before 
+    going back to its pool, thus a stale pointer finds the pattern in place of the virtual table of 
+    the node for as long as it stays there.  The oldest nodes are returned first once either the 
+    bytes or the nodes held reach their bound.  With @c BOOST_ZEROIZATION the memory is wiped on its 
+    way back to the pool rather than when the node is destroyed.
+
+    A stale pointer releasing its node checks for the pattern first and leaves the node alone.
+*/
+
+class quarantine
+{
+public:
+    /** Returns the memory of a node to its pool. */
+    typedef void (* release_type)(void * p, std::size_t n);
+
+    enum
+    {
+        /** Byte the memory is filled with. */
+        poison = 0xdb,
+
+        /** Bound of the nodes held. */
+        nodes = BOOST_SMART_PTR_QUARANTINE_NODES
+    };
+
+
+    /** Never destroyed, so that nodes can be destroyed in static destructors. */
+    static quarantine & instance()
+    {
+        static quarantine & r = * new quarantine;
+
+        return r;
+    }
+
+
+    /**
+        Tells whether a node is held in quarantine.
+
+        @param  p   Address of the node.
+    */
+
+    static bool poisoned(void const * p)
+    {
+        std::uintptr_t w;
+
+        std::memcpy(& w, p, sizeof(w));
+
+        return w == std::numeric_limits<std::uintptr_t>::max() / 0xff * poison;
+    }
+
+
+    /**
+        Poisons the memory of a destroyed node and holds it.
+
+        @param  p   Address of the node.
+        @param  n   Bytes of the node.
+        @param  r   Function returning the memory to its pool.
+    */
+
+    void hold(void * p, std::size_t n, release_type r) noexcept
+    {
+#ifndef BOOST_DISABLE_THREADS
+        std::scoped_lock guard(static_recursive_mutex());
+#endif
+
+        if (n > limit_)
+        {
+            r(p, n);
+
+            return;
+        }
+
+        std::memset(p, poison, n);
+
+        while (size_ == nodes || bytes_ + n > limit_)
+            evict();
+
+        fifo_[(head_ + size_ ++) % nodes] = entry{p, n, r};
+        bytes_ += n;
+    }
+
+
+    /**
+        Bounds the bytes held, returning the oldest nodes beyond.
+
+        @param  n   Bytes.
+    */
+
+    void limit(std::size_t n)
+    {
+#ifndef BOOST_DISABLE_THREADS
+        std::scoped_lock guard(static_recursive_mutex());
+#endif
+
+        limit_ = n;
+
+        while (bytes_ > limit_)
+            evict();
+    }
+
+
+    /**
+        Returns all nodes held.
+    */
+
+    void flush()
+    {
+#ifndef BOOST_DISABLE_THREADS
+        std::scoped_lock guard(static_recursive_mutex());
+#endif
+
+        while (size_)
+            evict();
+    }
+
+
+    /**
+        Bytes held.
+    */
+
+    std::size_t bytes() const
+    {
+#ifndef BOOST_DISABLE_THREADS
+        std::scoped_lock guard(static_recursive_mutex());
+#endif
+
+        return bytes_;
+    }
+
+private:
+    /** Node held. */
+    struct entry
+    {
+        void * p_;
+        std::size_t n_;
+        release_type r_;
+    };
+
+
+    quarantine()
+    : head_(0)
+    , size_(0)
+    , bytes_(0)
+    , limit_(BOOST_SMART_PTR_QUARANTINE_BYTES)
+    {
+    }
+
+    void evict() noexcept
+    {
+        entry const e = fifo_[head_];
+
+        head_ = (head_ + 1) % nodes;
+        -- size_;
+        bytes_ -= e.n_;
+
+        e.r_(e.p_, e.n_);
+    }
+
+
+    /** Oldest node held. */
+    std::size_t head_;
+
+    /** Nodes held. */
+    std::size_t size_;
+
+    /** Bytes held. */
+    std::size_t bytes_;
+
+    /** Bound of the bytes held. */
+    std::size_t limit_;
+
+    /** Nodes held, oldest first from @c head_ . */
+    entry fifo_[nodes];
+};
+
+
+} // namespace detail
+
+} // namespace smart_ptr
+
+
+/**
+    Bounds the bytes held in quarantine with @c BOOST_SMART_PTR_QUARANTINE , which defaults to 
+    @c BOOST_SMART_PTR_QUARANTINE_BYTES .
+
+    @param  n   Bytes.
+*/
+
+inline void quarantine_limit(std::size_t n)
+{
+    smart_ptr::detail::quarantine::instance().limit(n);
+}
+
+
+/**
+    Returns all nodes held in quarantine to their pool.
+*/
+
+inline void flush_quarantine()
+{
+    smart_ptr::detail::quarantine::instance().flush();
+}
+
+
+/**
+    Bytes held in quarantine.
+*/
+
+inline std::size_t quarantined_bytes()
+{
+    return smart_ptr::detail::quarantine::instance().bytes();
+}
+
+
+} // namespace boost
+
+
+#endif // #ifndef BOOST_DETAIL_QUARANTINE_HPP_INCLUDED
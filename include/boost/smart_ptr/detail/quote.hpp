@@ -0,0 +1,86 @@
+/**
+    \file
+    \brief Boost detail/quote.hpp header file.
+
+    Patent US11288049B2
+    'SOURCE TO SOURCE COMPILER, COMPILATION METHOD, AND
+    COMPUTER-READABLE MEDIUM FOR PREDICTABLE MEMORY MANAGEMENT'
+
+    Copyright (C) 2020-2026 Fornux LLC
+
+    Phil Bouchard, Founder & CEO
+    Fornux LLC
+    phil@fornux.com
+    3909 S Maryland Pkwy Ste 314 #638, Las Vegas, NV, 89119
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+
+#ifndef BOOST_DETAIL_QUOTE_HPP_INCLUDED
+#define BOOST_DETAIL_QUOTE_HPP_INCLUDED
+
+
+#include <ostream>
+
+
+namespace boost
+{
+
+namespace smart_ptr
+{
+
+namespace detail
+{
+
+
+/**
+    Writes a string between double quotes, escaped for JSON and Graphviz alike.
+
+    Quotes and backslashes are preceded by a backslash and control characters written as 
+    @c \\u00XX , so that no character is lost.
+
+    @param  out Stream written.
+    @param  p   String, or null for an empty one.
+*/
+
+inline std::ostream & quote(std::ostream & out, char const * p)
+{
+    static char const digits[] = "0123456789abcdef";
+
+    out << '"';
+
+    for (; p && * p; ++ p)
+    {
+        unsigned char const c = static_cast<unsigned char>(* p);
+
+        if (c == '"' || c == '\\')
+            out << '\\' << * p;
+        else if (c < 0x20)
+            out << "\\u00" << digits[c >> 4] << digits[c & 0xf];
+        else
+            out << * p;
+    }
+
+    return out << '"';
+}
+
+
+} // namespace detail
+
+} // namespace smart_ptr
+
+} // namespace boost
+
+
+#endif // #ifndef BOOST_DETAIL_QUOTE_HPP_INCLUDED
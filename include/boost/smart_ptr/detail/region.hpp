@@ -0,0 +1,456 @@
+/**
+    \file
+    \brief Boost detail/region.hpp header file.
+
+    Patent US11288049B2
+    'SOURCE TO SOURCE COMPILER, COMPILATION METHOD, AND
+    COMPUTER-READABLE MEDIUM FOR PREDICTABLE MEMORY MANAGEMENT'
+
+    Copyright (C) 2020-2026 Fornux LLC
+
+    Phil Bouchard, Founder & CEO
+    Fornux LLC
+    phil@fornux.com
+    3909 S Maryland Pkwy Ste 314 #638, Las Vegas, NV, 89119
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+
+#ifndef BOOST_DETAIL_REGION_HPP_INCLUDED
+#define BOOST_DETAIL_REGION_HPP_INCLUDED
+
+
+#include <new>
+#include <cstddef>
+#include <cstdint>
+
+#include <boost/core/no_exceptions_support.hpp>
+#include <boost/smart_ptr/detail/pages.hpp>
+#include <boost/smart_ptr/detail/zeroize.hpp>
+
+#ifndef BOOST_DISABLE_THREADS
+#include <mutex>
+#endif
+
+
+namespace boost
+{
+
+
+#ifndef BOOST_DISABLE_THREADS
+static std::recursive_mutex & static_recursive_mutex();
+#endif
+
+
+namespace smart_ptr
+{
+
+namespace detail
+{
+
+
+/**
+    Memory region.
+
+    Bump allocator owned by a @c node_proxy .  Blocks deallocated while the region is alive are
+    recycled by size class and all chunks are returned at once by @c release() .
+
+    With @c BOOST_ZEROIZATION blocks are wiped when deallocated, except after @c retire() where 
+    the wipe is left to @c release() which goes over each chunk in a single pass.
+
+    Chunks can be backed by huge pages to cut down TLB misses over large graphs.  In real-time mode 
+    the region is limited to a budget faulted in and locked up front, which it keeps across 
+    releases.
+*/
+
+class region
+{
+    /** Header of each chunk obtained from the system. */
+    struct alignas(std::max_align_t) chunk
+    {
+        chunk * next_;
+        std::size_t size_;
+
+        /** Alignment the chunk was mapped with, or 0 if it comes from @c operator new . */
+        std::size_t align_;
+    };
+
+    /** Recycled block. */
+    struct block
+    {
+        block * next_;
+    };
+
+public:
+    enum
+    {
+        /** Default size of a chunk. */
+        chunk_size = 64 * 1024,
+
+        /** Size class granularity. */
+        granularity = alignof(std::max_align_t),
+
+        /** Number of size classes; larger blocks are never recycled. */
+        classes = 64
+    };
+
+
+    region()
+    : head_(nullptr)
+    , next_(nullptr)
+    , end_(nullptr)
+    , size_(0)
+    , retired_(false)
+    , huge_(false)
+    , pinned_(nullptr)
+    , free_{}
+    {
+    }
+
+    region(region const &) = delete;
+
+    ~region()
+    {
+        release();
+
+        if (pinned_)
+            discard(pinned_);
+    }
+
+
+    /**
+        Allocates a block.
+
+        @param  n   Size in bytes.
+        @param  a   Alignment.
+        @return     Address of the new block.
+    */
+
+    void * allocate(std::size_t n, std::size_t a = alignof(std::max_align_t))
+    {
+#ifndef BOOST_DISABLE_THREADS
+        std::scoped_lock guard(static_recursive_mutex());
+#endif
+
+        std::size_t const c = size_class(n, a);
+
+        if (c < classes && free_[c])
+        {
+            block * p = free_[c];
+
+            free_[c] = p->next_;
+
+            return p;
+        }
+
+        if (c < classes)
+            n = (c + 1) * granularity;
+
+        char * p = align(next_, a);
+
+        if (! next_ || p + n > end_)
+        {
+            grow(n + a);
+
+            p = align(next_, a);
+        }
+
+        next_ = p + n;
+
+        return p;
+    }
+
+
+    /**
+        Deallocates a block.
+
+        @param  p   Address of the block.
+        @param  n   Size in bytes.
+        @param  a   Alignment.
+    */
+
+    void deallocate(void * p, std::size_t n, std::size_t a = alignof(std::max_align_t))
+    {
+#ifndef BOOST_DISABLE_THREADS
+        std::scoped_lock guard(static_recursive_mutex());
+#endif
+
+        std::size_t const c = size_class(n, a);
+
+#ifdef BOOST_ZEROIZATION
+        if (! retired_)
+            zeroize(p, c < classes ? (c + 1) * granularity : n);
+#endif
+
+        if (c < classes)
+        {
+            block * q = static_cast<block *>(p);
+
+            q->next_ = free_[c];
+            free_[c] = q;
+        }
+    }
+
+
+    /**
+        Backs the chunks obtained from now on with huge pages.
+
+        @param  b   Whether to use huge pages.
+    */
+
+    void huge_pages(bool b)
+    {
+#ifndef BOOST_DISABLE_THREADS
+        std::scoped_lock guard(static_recursive_mutex());
+#endif
+
+        huge_ = b;
+    }
+
+
+    /**
+        Limits the region to a budget mapped, faulted in and locked in RAM up front.
+
+        Allocations beyond throw @c budget_exceeded instead of growing the region.
+
+        @pre        No block is allocated.
+        @param  n   Budget in bytes.
+    */
+
+    void realtime(std::size_t n)
+    {
+#ifndef BOOST_DISABLE_THREADS
+        std::scoped_lock guard(static_recursive_mutex());
+#endif
+
+        chunk * p = pinned_;
+
+        pinned_ = nullptr;
+        release();
+
+        if (p)
+            discard(p);
+
+        std::size_t const a = huge_ ? huge_page_size : page_size;
+        std::size_t const s = (sizeof(chunk) + n + a - 1) / a * a;
+
+        p = static_cast<chunk *>(map_pages(s, a, huge_));
+
+        BOOST_TRY
+        {
+            lock_pages(p, s);
+        }
+        BOOST_CATCH (...)
+        {
+            unmap_pages(p, s, a);
+
+            BOOST_RETHROW
+        }
+        BOOST_CATCH_END
+
+        p->next_ = nullptr;
+        p->size_ = s;
+        p->align_ = a;
+
+        pinned_ = p;
+        next_ = reinterpret_cast<char *>(p + 1);
+        end_ = reinterpret_cast<char *>(p) + s;
+        size_ = s;
+    }
+
+
+    /**
+        Tells that all blocks are about to be deallocated, ahead of @c release() .
+    */
+
+    void retire()
+    {
+#ifndef BOOST_DISABLE_THREADS
+        std::scoped_lock guard(static_recursive_mutex());
+#endif
+
+        retired_ = true;
+    }
+
+
+    /**
+        Returns all chunks to the system.
+    */
+
+    void release()
+    {
+#ifndef BOOST_DISABLE_THREADS
+        std::scoped_lock guard(static_recursive_mutex());
+#endif
+
+        for (chunk * p = head_, * q; p; p = q)
+        {
+            q = p->next_;
+
+#ifdef BOOST_ZEROIZATION
+            // the header tells discard() how the chunk was obtained
+            zeroize(p + 1, p->size_ - sizeof(chunk));
+#endif
+
+            discard(p);
+        }
+
+        head_ = nullptr;
+        retired_ = false;
+
+        if (pinned_)
+        {
+            // the budget is kept, starting over from its beginning
+#ifdef BOOST_ZEROIZATION
+            zeroize(pinned_ + 1, next_ - reinterpret_cast<char *>(pinned_ + 1));
+#endif
+
+            next_ = reinterpret_cast<char *>(pinned_ + 1);
+            end_ = reinterpret_cast<char *>(pinned_) + pinned_->size_;
+            size_ = pinned_->size_;
+        }
+        else
+        {
+            next_ = nullptr;
+            end_ = nullptr;
+            size_ = 0;
+        }
+
+        for (block * & i : free_)
+            i = nullptr;
+    }
+
+
+    /**
+        Bytes obtained from the system.
+    */
+
+    std::size_t size() const
+    {
+        return size_;
+    }
+
+
+    /**
+        Bytes left at the end of the current chunk.
+    */
+
+    std::size_t tail() const
+    {
+        return end_ - next_;
+    }
+
+
+    /**
+        Bytes deallocated and waiting to be recycled.
+    */
+
+    std::size_t recycled() const
+    {
+#ifndef BOOST_DISABLE_THREADS
+        std::scoped_lock guard(static_recursive_mutex());
+#endif
+
+        std::size_t n = 0;
+
+        for (std::size_t c = 0; c < classes; ++ c)
+            for (block * p = free_[c]; p; p = p->next_)
+                n += (c + 1) * granularity;
+
+        return n;
+    }
+
+private:
+    static std::size_t size_class(std::size_t n, std::size_t a)
+    {
+        if (a > granularity || n == 0)
+            return classes;
+
+        return (n - 1) / granularity;
+    }
+
+    static char * align(char * p, std::size_t a)
+    {
+        return reinterpret_cast<char *>((reinterpret_cast<std::uintptr_t>(p) + a - 1) & ~ (a - 1));
+    }
+
+    static void discard(chunk * p)
+    {
+        if (p->align_)
+            unmap_pages(p, p->size_, p->align_);
+        else
+            ::operator delete(p);
+    }
+
+    void grow(std::size_t n)
+    {
+        if (pinned_)
+            boost::throw_exception(budget_exceeded());
+
+        std::size_t s = sizeof(chunk) + (n > chunk_size ? n : std::size_t(chunk_size));
+        chunk * p;
+
+        if (huge_)
+        {
+            s = (s + huge_page_size - 1) / huge_page_size * huge_page_size;
+            p = static_cast<chunk *>(map_pages(s, huge_page_size, true));
+        }
+        else
+            p = static_cast<chunk *>(::operator new(s));
+
+        p->next_ = head_;
+        p->size_ = s;
+        p->align_ = huge_ ? huge_page_size : 0;
+        head_ = p;
+
+        next_ = reinterpret_cast<char *>(p + 1);
+        end_ = reinterpret_cast<char *>(p) + s;
+        size_ += s;
+    }
+
+
+    /** Chunks. */
+    chunk * head_;
+
+    /** Next free byte of the current chunk. */
+    char * next_;
+
+    /** End of the current chunk. */
+    char * end_;
+
+    /** Bytes obtained from the system. */
+    std::size_t size_;
+
+    /** Wipe left to @c release() . */
+    bool retired_;
+
+    /** New chunks are backed by huge pages. */
+    bool huge_;
+
+    /** Budget of the real-time mode. */
+    chunk * pinned_;
+
+    /** Recycled blocks by size class. */
+    block * free_[classes];
+};
+
+
+} // namespace detail
+
+} // namespace smart_ptr
+
+} // namespace boost
+
+
+#endif // #ifndef BOOST_DETAIL_REGION_HPP_INCLUDED
@@ -0,0 +1,549 @@
+/**
+    \file
+    \brief Boost detail/reporter.hpp header file.
+
+    Patent US11288049B2
+    'SOURCE TO SOURCE COMPILER, COMPILATION METHOD, AND
+    COMPUTER-READABLE MEDIUM FOR PREDICTABLE MEMORY MANAGEMENT'
+
+    Copyright (C) 2020-2026 Fornux LLC
+
+    Phil Bouchard, Founder & CEO
+    Fornux LLC
+    phil@fornux.com
+    3909 S Maryland Pkwy Ste 314 #638, Las Vegas, NV, 89119
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+
+#ifndef BOOST_DETAIL_REPORTER_HPP_INCLUDED
+#define BOOST_DETAIL_REPORTER_HPP_INCLUDED
+
+
+#include <atomic>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <ostream>
+#include <iostream>
+
+#ifndef BOOST_DISABLE_THREADS
+#include <mutex>
+#include <chrono>
+#include <thread>
+#include <condition_variable>
+#endif
+
+#include <boost/core/demangle.hpp>
+#include <boost/smart_ptr/detail/quote.hpp>
+
+
+namespace boost
+{
+
+
+/**
+    Format of the reports written to a file.
+*/
+
+enum class report_format
+{
+    /** One JSON object per line. */
+    json,
+
+    /** Fixed header followed by the length of each string and its characters, per event. */
+    binary
+};
+
+
+namespace smart_ptr
+{
+
+namespace detail
+{
+
+
+/**
+    Event of a checked build.
+*/
+
+enum class report_kind : unsigned char
+{
+    memory_leak,
+    use_after_free,
+    out_of_bounds
+};
+
+
+/**
+    Event recorded by a thread, strings being static.
+*/
+
+struct report_event
+{
+    report_kind kind_;
+
+    /** Line of the call site. */
+    unsigned line_;
+
+    /** Occurrences at the call site so far on the thread. */
+    std::size_t count_;
+
+    /** Bytes of the pointee object. */
+    std::size_t size_;
+
+    /** Innermost @c node_proxy . */
+    void const * proxy_;
+
+    char const * file_;
+    char const * function_;
+
+    /** Mangled name of the pointee type. */
+    char const * type_;
+};
+
+
+/**
+    Ring buffer of the events of a thread.
+
+    Written by its thread and read by the flusher only, thus lock-free.  Events of a call site are 
+    deduplicated: only the occurrences numbered by a power of two are recorded, with their count.
+*/
+
+class report_ring
+{
+public:
+    enum
+    {
+        /** Events held until the next flush. */
+        capacity = 256,
+
+        /** Call sites counted per thread. */
+        sites = 128
+    };
+
+
+    /**
+        Records an event if its call site is not being deduplicated, or drops it if the ring is full.
+    */
+
+    void push(report_event e)
+    {
+        e.count_ = hit(e);
+
+        if (e.count_ & (e.count_ - 1))
+            return;
+
+        std::size_t const h = head_.load(std::memory_order_relaxed);
+
+        if (h - tail_.load(std::memory_order_acquire) == capacity)
+        {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+
+            return;
+        }
+
+        events_[h % capacity] = e;
+        head_.store(h + 1, std::memory_order_release);
+    }
+
+
+    /**
+        Calls @c f with each event recorded since the last call.
+    */
+
+    template <typename F>
+        void drain(F f)
+        {
+            std::size_t t = tail_.load(std::memory_order_relaxed);
+            std::size_t const h = head_.load(std::memory_order_acquire);
+
+            for (; t != h; ++ t)
+                f(events_[t % capacity]);
+
+            tail_.store(t, std::memory_order_release);
+        }
+
+
+    /** Events recorded. */
+    std::size_t size() const
+    {
+        return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+    }
+
+    /** Events dropped since the last call. */
+    std::size_t dropped()
+    {
+        return dropped_.exchange(0, std::memory_order_relaxed);
+    }
+
+    /** Next ring of all rings. */
+    report_ring * next_ = nullptr;
+
+    /** Thread exited. */
+    std::atomic<bool> done_{false};
+
+private:
+    /** Occurrences of a call site. */
+    struct site
+    {
+        char const * file_;
+        char const * type_;
+        unsigned line_;
+        report_kind kind_;
+        std::size_t count_;
+    };
+
+
+    std::size_t hit(report_event const & e)
+    {
+        std::size_t i = (reinterpret_cast<std::uintptr_t>(e.file_) ^ reinterpret_cast<std::uintptr_t>(e.type_) ^ e.line_ * 31 ^ std::size_t(e.kind_)) % sites;
+
+        for (std::size_t n = 0; n < sites; ++ n, i = (i + 1) % sites)
+        {
+            site & s = sites_[i];
+
+            if (! s.count_)
+            {
+                s = site{e.file_, e.type_, e.line_, e.kind_, 1};
+
+                return 1;
+            }
+
+            if (s.file_ == e.file_ && s.type_ == e.type_ && s.line_ == e.line_ && s.kind_ == e.kind_)
+                return ++ s.count_;
+        }
+
+        // too many call sites: every occurrence is recorded
+        return 1;
+    }
+
+
+    report_event events_[capacity];
+
+    std::atomic<std::size_t> head_{0};
+    std::atomic<std::size_t> tail_{0};
+    std::atomic<std::size_t> dropped_{0};
+
+    site sites_[sites] = {};
+};
+
+
+/**
+    Collects the rings of all threads and writes their events to a file, or else to @c std::cerr , 
+    from a background thread.
+*/
+
+class reporter
+{
+public:
+#ifndef BOOST_DISABLE_THREADS
+    /** Delay between two flushes. */
+    static constexpr std::chrono::milliseconds period{100};
+#endif
+
+
+    static reporter & instance()
+    {
+        static reporter r;
+
+        return r;
+    }
+
+
+    /**
+        Records an event from the calling thread.
+    */
+
+    static void report(report_event const & e)
+    {
+        // events of static destructors called after the reporter are lost
+        if (destroyed())
+            return;
+
+        report_ring * r = ring();
+
+#ifndef BOOST_DISABLE_THREADS
+        // shared by the exiting threads
+        if (r == & instance().late_)
+        {
+            std::scoped_lock guard(instance().mutex_);
+
+            r->push(e);
+
+            return;
+        }
+#endif
+
+        r->push(e);
+
+#ifdef BOOST_DISABLE_THREADS
+        // no flusher
+        if (r->size() == report_ring::capacity)
+            instance().flush();
+#endif
+    }
+
+
+    /**
+        Writes the events to a file from now on.
+    */
+
+    void open(char const * path, report_format f)
+    {
+#ifndef BOOST_DISABLE_THREADS
+        std::scoped_lock guard(mutex_);
+#endif
+
+        flush_locked();
+
+        file_.reset(new std::ofstream(path, f == report_format::binary ? std::ios::binary | std::ios::trunc : std::ios::trunc));
+        format_ = f;
+    }
+
+
+    /**
+        Writes the events recorded so far.
+    */
+
+    void flush()
+    {
+#ifndef BOOST_DISABLE_THREADS
+        std::scoped_lock guard(mutex_);
+#endif
+
+        flush_locked();
+    }
+
+private:
+    reporter()
+#ifndef BOOST_DISABLE_THREADS
+    : thread_([this]
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+
+        while (! condition_.wait_for(lock, period, [this] { return stop_; }))
+            flush_locked();
+    })
+#endif
+    {
+    }
+
+    ~reporter()
+    {
+#ifndef BOOST_DISABLE_THREADS
+        {
+            std::scoped_lock guard(mutex_);
+
+            stop_ = true;
+        }
+
+        condition_.notify_one();
+        thread_.join();
+#endif
+
+        flush();
+
+        destroyed() = true;
+    }
+
+
+    static bool & destroyed()
+    {
+        static bool b = false;
+
+        return b;
+    }
+
+    /** Ring of the calling thread. */
+    static report_ring * ring()
+    {
+        if (local_)
+            return local_;
+
+        return claim();
+    }
+
+    /** Gives a ring to the calling thread. */
+    static report_ring * claim()
+    {
+        struct holder
+        {
+            ~holder()
+            {
+                reporter & r = instance();
+
+                local_->done_.store(true, std::memory_order_release);
+
+                // from destructors of thread locals destroyed later on, the ring being deleted 
+                // by the next flush
+                local_ = & r.late_;
+            }
+        };
+
+        reporter & r = instance();
+        report_ring * p = new report_ring;
+
+        {
+#ifndef BOOST_DISABLE_THREADS
+            std::scoped_lock guard(r.mutex_);
+#endif
+
+            p->next_ = r.rings_;
+            r.rings_ = p;
+            local_ = p;
+        }
+
+        static thread_local holder h;
+
+        return local_;
+    }
+
+    void flush_locked()
+    {
+        std::ostream & out = file_ ? * file_ : std::cerr;
+
+        late_.drain([this, & out] (report_event const & e) { write(out, e); });
+
+        if (std::size_t n = late_.dropped())
+            write(out, n);
+
+        for (report_ring ** p = & rings_; * p; )
+        {
+            report_ring * r = * p;
+            bool const done = r->done_.load(std::memory_order_acquire);
+
+            r->drain([this, & out] (report_event const & e) { write(out, e); });
+
+            if (std::size_t n = r->dropped())
+                write(out, n);
+
+            if (done)
+            {
+                * p = r->next_;
+
+                delete r;
+            }
+            else
+                p = & r->next_;
+        }
+
+        out.flush();
+    }
+
+    void write(std::ostream & out, report_event const & e)
+    {
+        static char const * const kinds[] = {"memory leak", "use after free", "out of bounds"};
+
+        std::string const type = core::demangle(e.type_ ? e.type_ : "");
+
+        if (format_ == report_format::binary)
+        {
+            std::uint64_t const h[] = {std::uint64_t(e.kind_), e.count_, e.size_, reinterpret_cast<std::uintptr_t>(e.proxy_), e.line_};
+
+            out.write(reinterpret_cast<char const *>(h), sizeof(h));
+
+            for (char const * s : {e.file_, e.function_, type.c_str()})
+            {
+                std::uint32_t const n = s ? std::char_traits<char>::length(s) : 0;
+
+                out.write(reinterpret_cast<char const *>(& n), sizeof(n));
+                out.write(s, n);
+            }
+
+            return;
+        }
+
+        out << "{\"event\":\"" << kinds[std::size_t(e.kind_)] << "\",\"count\":" << e.count_ << ",\"size\":" << e.size_ << ",\"type\":";
+        quote(out, type.c_str()) << ",\"proxy\":\"" << e.proxy_ << "\",\"function\":";
+        quote(out, e.function_) << ",\"file\":";
+        quote(out, e.file_) << ",\"line\":" << e.line_ << "}\n";
+    }
+
+    /** Events dropped by a full ring. */
+    void write(std::ostream & out, std::size_t n)
+    {
+        if (format_ == report_format::binary)
+        {
+            std::uint64_t const h[] = {std::uint64_t(-1), n, 0, 0, 0};
+            std::uint32_t const z[] = {0, 0, 0};
+
+            out.write(reinterpret_cast<char const *>(h), sizeof(h));
+            out.write(reinterpret_cast<char const *>(z), sizeof(z));
+
+            return;
+        }
+
+        out << "{\"event\":\"dropped\",\"count\":" << n << "}\n";
+    }
+
+
+    static inline thread_local report_ring * local_ = nullptr;
+
+    /** Rings of all threads. */
+    report_ring * rings_ = nullptr;
+
+    /** Ring of the threads whose own ring was retired, written under the lock. */
+    report_ring late_;
+
+    /** File written, or else @c std::cerr . */
+    std::unique_ptr<std::ofstream> file_;
+
+    report_format format_ = report_format::json;
+
+#ifndef BOOST_DISABLE_THREADS
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    bool stop_ = false;
+
+    /** Flusher; declared last so that it starts once everything else is initialized. */
+    std::thread thread_;
+#endif
+};
+
+
+} // namespace detail
+
+} // namespace smart_ptr
+
+
+/**
+    Writes the reports of the checked build (@c BOOST_REPORT ) to a file from now on, instead of 
+    @c std::cerr .
+
+    @param  path    File truncated.
+    @param  f       Format.
+*/
+
+inline void report_to(char const * path, report_format f = report_format::json)
+{
+    smart_ptr::detail::reporter::instance().open(path, f);
+}
+
+
+/**
+    Writes the reports recorded so far without waiting for the background flush.
+*/
+
+inline void flush_reports()
+{
+    smart_ptr::detail::reporter::instance().flush();
+}
+
+
+} // namespace boost
+
+
+#endif // #ifndef BOOST_DETAIL_REPORTER_HPP_INCLUDED
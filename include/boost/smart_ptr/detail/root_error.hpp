@@ -0,0 +1,182 @@
+/**
+    \file
+    \brief Boost detail/root_error.hpp header file.
+
+    Patent US11288049B2
+    'SOURCE TO SOURCE COMPILER, COMPILATION METHOD, AND
+    COMPUTER-READABLE MEDIUM FOR PREDICTABLE MEMORY MANAGEMENT'
+
+    Copyright (C) 2020-2026 Fornux LLC
+
+    Phil Bouchard, Founder & CEO
+    Fornux LLC
+    phil@fornux.com
+    3909 S Maryland Pkwy Ste 314 #638, Las Vegas, NV, 89119
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+
+#ifndef BOOST_DETAIL_ROOT_ERROR_HPP_INCLUDED
+#define BOOST_DETAIL_ROOT_ERROR_HPP_INCLUDED
+
+
+#include <cstdio>
+#include <cstddef>
+#include <stdexcept>
+
+#include <boost/config.hpp>
+
+
+#if defined(__GNUC__)
+#define BOOST_SMART_PTR_COLD __attribute__((cold))
+#else
+#define BOOST_SMART_PTR_COLD
+#endif
+
+
+namespace boost
+{
+
+
+/**
+    Failed check of a @c root_ptr or a @c root_array .
+
+    Holds a fixed-size record of the check and of the chain of @c node_proxy it failed in, so that 
+    throwing does not allocate.  The message is only formatted by @c what() .
+*/
+
+class root_error : public std::out_of_range
+{
+public:
+    /** Check that failed. */
+    enum kind_type
+    {
+        null_pointer,
+        out_of_bounds,
+        bad_cast,
+        use_after_free
+    };
+
+    enum
+    {
+        /** Innermost @c node_proxy recorded. */
+        frames = 16
+    };
+
+    /** Call site of a @c node_proxy . */
+    struct frame
+    {
+        char const * file_;
+        char const * function_;
+        unsigned line_;
+    };
+
+
+    /**
+        Initialization.
+
+        @param  k   Check.
+        @param  i   Index out of bounds.
+        @param  n   Bound.
+    */
+
+    root_error(kind_type k, long long i = 0, std::size_t n = 0) noexcept
+    : std::out_of_range(prototype_)
+    , kind_(k)
+    , index_(i)
+    , bound_(n)
+    , depth_(0)
+    , formatted_(false)
+    {
+    }
+
+
+    /**
+        Records the next outer @c node_proxy , if there is room left.
+    */
+
+    void push(char const * file, char const * function, unsigned line) noexcept
+    {
+        if (depth_ < frames)
+            frames_[depth_ ++] = frame{file, function, line};
+    }
+
+
+    kind_type kind() const noexcept
+    {
+        return kind_;
+    }
+
+    long long index() const noexcept
+    {
+        return index_;
+    }
+
+    std::size_t bound() const noexcept
+    {
+        return bound_;
+    }
+
+
+    /**
+        Message followed by the chain of @c node_proxy , one per line.
+    */
+
+    char const * what() const noexcept override
+    {
+        if (formatted_)
+            return what_;
+
+        int n;
+
+        switch (kind_)
+        {
+        case null_pointer: n = std::snprintf(what_, sizeof(what_), "null pointer\n"); break;
+        case out_of_bounds: n = std::snprintf(what_, sizeof(what_), "index %lld out of range [0, %zu[\n", index_, bound_); break;
+        case use_after_free: n = std::snprintf(what_, sizeof(what_), "use after free\n"); break;
+        default: n = std::snprintf(what_, sizeof(what_), "internal error\n"); break;
+        }
+
+        for (std::size_t i = 0; i < depth_ && n >= 0 && std::size_t(n) < sizeof(what_); ++ i)
+            n += std::snprintf(what_ + n, sizeof(what_) - n, "#%zu %s in %s line %u\n", i, frames_[i].function_, frames_[i].file_, frames_[i].line_);
+
+        formatted_ = true;
+
+        return what_;
+    }
+
+private:
+    /** 
+        Base sharing its message, thus copied without allocating.  Built eagerly rather than on the 
+        first throw, where building it could throw in turn.
+    */
+    static inline std::out_of_range const prototype_{"root_ptr"};
+
+
+    kind_type kind_;
+    long long index_;
+    std::size_t bound_;
+
+    frame frames_[frames];
+    std::size_t depth_;
+
+    mutable char what_[1024];
+    mutable bool formatted_;
+};
+
+
+} // namespace boost
+
+
+#endif // #ifndef BOOST_DETAIL_ROOT_ERROR_HPP_INCLUDED
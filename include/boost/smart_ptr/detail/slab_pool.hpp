@@ -0,0 +1,653 @@
+/**
+    \file
+    \brief Boost detail/slab_pool.hpp header file.
+
+    Patent US11288049B2
+    'SOURCE TO SOURCE COMPILER, COMPILATION METHOD, AND
+    COMPUTER-READABLE MEDIUM FOR PREDICTABLE MEMORY MANAGEMENT'
+
+    Copyright (C) 2020-2026 Fornux LLC
+
+    Phil Bouchard, Founder & CEO
+    Fornux LLC
+    phil@fornux.com
+    3909 S Maryland Pkwy Ste 314 #638, Las Vegas, NV, 89119
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+
+#ifndef BOOST_DETAIL_SLAB_POOL_HPP_INCLUDED
+#define BOOST_DETAIL_SLAB_POOL_HPP_INCLUDED
+
+
+#include <new>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+
+#include <boost/smart_ptr/detail/pages.hpp>
+
+#ifndef BOOST_DISABLE_THREADS
+#include <mutex>
+#endif
+
+#if defined(__cpp_constinit)
+#define BOOST_SMART_PTR_CONSTINIT constinit
+#else
+#define BOOST_SMART_PTR_CONSTINIT
+#endif
+
+
+namespace boost
+{
+
+
+#ifndef BOOST_DISABLE_THREADS
+static std::recursive_mutex & static_recursive_mutex();
+#endif
+
+
+namespace smart_ptr
+{
+
+namespace detail
+{
+
+
+/**
+    Pool of chunks of a fixed size and alignment.
+
+    Chunks are carved out of slabs aligned on their own size, thus the slab of a chunk is found by 
+    masking its address.  Slabs whose chunks are all free are kept aside and returned to the 
+    system by @c release_memory() .
+
+    In real-time mode the pool is limited to slabs mapped and locked up front by @c realtime() , 
+    so allocations never fault nor call the system.
+
+    With @c BOOST_SMART_PTR_HUGE_PAGES slabs are at least a huge page large and backed by one.
+
+    @note Instances are never destroyed: nodes may outlive static destruction.
+*/
+
+class slab_pool
+{
+    /** Free chunk. */
+    struct chunk
+    {
+        chunk * next_;
+    };
+
+    /** Header at the beginning of each slab. */
+    struct slab
+    {
+        slab * next_;
+        slab * prev_;
+
+        /** List the slab belongs to. */
+        slab ** list_;
+
+        /** Chunks deallocated. */
+        chunk * free_;
+
+        /** First chunk never allocated. */
+        char * unused_;
+
+        /** Chunks allocated. */
+        std::size_t live_;
+    };
+
+public:
+    enum
+    {
+        /** Minimal size of a slab. */
+#ifdef BOOST_SMART_PTR_HUGE_PAGES
+        slab_size = huge_page_size,
+#else
+        slab_size = 64 * 1024,
+#endif
+
+        /** Minimal number of chunks per slab. */
+        slab_chunks = 16,
+
+        /** Size from which objects bypass the pools and are mapped on their own. */
+#ifdef BOOST_SMART_PTR_LARGE_OBJECT
+        large_object = BOOST_SMART_PTR_LARGE_OBJECT
+#else
+        large_object = 64 * 1024
+#endif
+    };
+
+
+    /**
+        Initialization of a pool.
+
+        @param  s   Size of the chunks.
+        @param  a   Alignment of the chunks.
+        @param  n   Whether the chunks hold nodes.
+    */
+
+    constexpr slab_pool(std::size_t s, std::size_t a, bool n = false) noexcept
+    : size_(round(s < sizeof(chunk) ? sizeof(chunk) : s, a < alignof(chunk) ? alignof(chunk) : a))
+    , offset_(round(sizeof(slab), a < alignof(chunk) ? alignof(chunk) : a))
+    , slab_size_(power(offset_ + size_ * slab_chunks))
+    , alignment_(a)
+    , nodes_(n)
+    , avail_(nullptr)
+    , empty_(nullptr)
+    , full_(nullptr)
+    , slabs_(0)
+    , live_(0)
+    , reserved_(0)
+    , next_pool_(nullptr)
+    , registered_(false)
+    , fixed_(false)
+    {
+    }
+
+    slab_pool(slab_pool const &) = delete;
+
+
+    /**
+        Pool shared by all chunks of size @c S and alignment @c A , kept apart for nodes so that 
+        their chunks can be inspected.
+    */
+
+    template <std::size_t S, std::size_t A, bool N = false>
+        static slab_pool & instance()
+        {
+            // constant initialized and trivially destructible: no guard, no exit handler
+            static BOOST_SMART_PTR_CONSTINIT slab_pool p(S, A, N);
+
+            return p;
+        }
+
+
+    /**
+        Allocates a chunk.
+    */
+
+    void * allocate()
+    {
+#ifndef BOOST_DISABLE_THREADS
+        std::scoped_lock guard(static_recursive_mutex());
+#endif
+
+        slab * s = avail_;
+
+        if (! s)
+        {
+            s = empty_ ? empty_ : map();
+
+            unlink(s);
+            link(avail_, s);
+        }
+
+        void * p;
+
+        if (s->free_)
+        {
+            p = s->free_;
+            s->free_ = s->free_->next_;
+        }
+        else
+        {
+            p = s->unused_;
+            s->unused_ += size_;
+        }
+
+        ++ s->live_;
+        ++ live_;
+
+        if (! s->free_ && s->unused_ + size_ > reinterpret_cast<char *>(s) + slab_size_)
+        {
+            unlink(s);
+            link(full_, s);
+        }
+
+        return p;
+    }
+
+
+    /**
+        Deallocates a chunk.
+
+        @param  p   Address of the chunk.
+    */
+
+    void deallocate(void * p)
+    {
+#ifndef BOOST_DISABLE_THREADS
+        std::scoped_lock guard(static_recursive_mutex());
+#endif
+
+        slab * s = reinterpret_cast<slab *>(reinterpret_cast<std::uintptr_t>(p) & ~ (slab_size_ - 1));
+        chunk * c = static_cast<chunk *>(p);
+
+        c->next_ = s->free_;
+        s->free_ = c;
+
+        -- live_;
+
+        if (-- s->live_ == 0)
+        {
+            // start over from the beginning of the slab
+            s->free_ = nullptr;
+            s->unused_ = reinterpret_cast<char *>(s) + offset_;
+
+            unlink(s);
+            link(empty_, s);
+        }
+        else if (s->list_ == & full_)
+        {
+            unlink(s);
+            link(avail_, s);
+        }
+    }
+
+
+    /**
+        Maps and faults in enough slabs for @c n chunks ahead of time.
+
+        These slabs are kept by @c release_memory() afterwards.
+
+        @param  n   Number of chunks.
+    */
+
+    void reserve(std::size_t n)
+    {
+#ifndef BOOST_DISABLE_THREADS
+        std::scoped_lock guard(static_recursive_mutex());
+#endif
+
+        if (reserved_ < n)
+            reserved_ = n;
+
+        while (capacity() < n)
+        {
+            slab * s = map();
+
+            fault_pages(s, slab_size_);
+
+            link(empty_, s);
+        }
+    }
+
+
+    /**
+        Limits the pool to enough slabs for @c n chunks, faulted in and locked in RAM up front.
+
+        Allocations beyond throw @c budget_exceeded instead of growing the pool, and no slab is 
+        returned to the system anymore.
+
+        @param  n   Number of chunks.
+    */
+
+    void realtime(std::size_t n)
+    {
+#ifndef BOOST_DISABLE_THREADS
+        std::scoped_lock guard(static_recursive_mutex());
+#endif
+
+        reserve(n);
+
+        for (slab * l : {avail_, empty_, full_})
+            for (slab * s = l; s; s = s->next_)
+                lock_pages(s, slab_size_);
+
+        fixed_ = true;
+    }
+
+
+    /**
+        Returns the slabs whose chunks are all free to the system.
+
+        @param  keep    Bytes of free slabs to keep for later allocations.
+        @return         Bytes returned.
+    */
+
+    std::size_t release_memory(std::size_t keep = 0)
+    {
+#ifndef BOOST_DISABLE_THREADS
+        std::scoped_lock guard(static_recursive_mutex());
+#endif
+
+        std::size_t n = 0, k = 0;
+
+        for (slab * s = empty_, * t; s; s = t)
+        {
+            t = s->next_;
+
+            if (fixed_ || k + slab_size_ <= keep || capacity() - chunks() < reserved_)
+            {
+                k += slab_size_;
+
+                continue;
+            }
+
+            unlink(s);
+            unmap(s);
+
+            n += slab_size_;
+        }
+
+        return n;
+    }
+
+
+    /**
+        Returns the slabs of every pool whose chunks are all free to the system.
+
+        @param  keep    Bytes of free slabs each pool keeps for later allocations.
+        @return         Bytes returned.
+    */
+
+    static std::size_t release_all(std::size_t keep = 0)
+    {
+#ifndef BOOST_DISABLE_THREADS
+        std::scoped_lock guard(static_recursive_mutex());
+#endif
+
+        std::size_t n = 0;
+
+        for (slab_pool * p = pools(); p; p = p->next_pool_)
+            n += p->release_memory(keep);
+
+        return n;
+    }
+
+
+    /**
+        Calls @c f with each pool obtained slabs from the system, under the global mutex.
+    */
+
+    template <typename F>
+        static void for_each(F f)
+        {
+#ifndef BOOST_DISABLE_THREADS
+            std::scoped_lock guard(static_recursive_mutex());
+#endif
+
+            for (slab_pool * p = pools(); p; p = p->next_pool_)
+                f(* p);
+        }
+
+
+    /**
+        Calls @c f with the address of each chunk allocated, under the global mutex.
+    */
+
+    template <typename F>
+        void for_each_live(F f) const
+        {
+#ifndef BOOST_DISABLE_THREADS
+            std::scoped_lock guard(static_recursive_mutex());
+#endif
+
+            std::vector<bool> freed(chunks());
+
+            for (slab * l : {avail_, full_})
+                for (slab * s = l; s; s = s->next_)
+                {
+                    char * const b = reinterpret_cast<char *>(s) + offset_;
+
+                    freed.assign(freed.size(), false);
+
+                    for (chunk * c = s->free_; c; c = c->next_)
+                        freed[(reinterpret_cast<char *>(c) - b) / size_] = true;
+
+                    for (char * p = b; p < s->unused_; p += size_)
+                        if (! freed[(p - b) / size_])
+                            f(static_cast<void *>(p));
+                }
+        }
+
+
+    /** Size of the chunks. */
+    std::size_t chunk_size() const
+    {
+        return size_;
+    }
+
+    /** Bytes obtained from the system. */
+    std::size_t size() const
+    {
+        return slabs_ * slab_size_;
+    }
+
+    /** Chunks allocated. */
+    std::size_t live() const
+    {
+        return live_;
+    }
+
+    /** Chunks the slabs obtained can hold. */
+    std::size_t capacity() const
+    {
+        return slabs_ * chunks();
+    }
+
+    /** Alignment of the chunks. */
+    std::size_t alignment() const
+    {
+        return alignment_;
+    }
+
+    /** Size of the slabs. */
+    std::size_t slab_bytes() const
+    {
+        return slab_size_;
+    }
+
+    /** Chunks per slab. */
+    std::size_t chunks() const
+    {
+        return (slab_size_ - offset_) / size_;
+    }
+
+    /** Slabs with all chunks free. */
+    std::size_t empty() const
+    {
+        std::size_t n = 0;
+
+        for (slab * s = empty_; s; s = s->next_)
+            ++ n;
+
+        return n;
+    }
+
+    /** Chunks hold nodes. */
+    bool nodes() const
+    {
+        return nodes_;
+    }
+
+private:
+    static constexpr std::size_t round(std::size_t n, std::size_t a)
+    {
+        return (n + a - 1) / a * a;
+    }
+
+    static constexpr std::size_t power(std::size_t n)
+    {
+        std::size_t p = slab_size;
+
+        while (p < n)
+            p *= 2;
+
+        return p;
+    }
+
+    static slab_pool * & pools()
+    {
+        static slab_pool * head = nullptr;
+
+        return head;
+    }
+
+    static void link(slab * & l, slab * s)
+    {
+        s->list_ = & l;
+        s->prev_ = nullptr;
+        s->next_ = l;
+
+        if (l)
+            l->prev_ = s;
+
+        l = s;
+    }
+
+    static void unlink(slab * s)
+    {
+        if (! s->list_)
+            return;
+
+        if (s->prev_)
+            s->prev_->next_ = s->next_;
+        else
+            * s->list_ = s->next_;
+
+        if (s->next_)
+            s->next_->prev_ = s->prev_;
+
+        s->list_ = nullptr;
+    }
+
+    slab * map()
+    {
+        if (fixed_)
+            boost::throw_exception(budget_exceeded());
+
+        if (! registered_)
+        {
+            registered_ = true;
+            next_pool_ = pools();
+            pools() = this;
+        }
+
+#ifdef BOOST_SMART_PTR_HUGE_PAGES
+        char * q = static_cast<char *>(map_pages(slab_size_, slab_size_, true));
+#else
+        char * q = static_cast<char *>(map_pages(slab_size_, slab_size_));
+#endif
+
+        slab * s = reinterpret_cast<slab *>(q);
+
+        s->next_ = nullptr;
+        s->prev_ = nullptr;
+        s->list_ = nullptr;
+        s->free_ = nullptr;
+        s->unused_ = q + offset_;
+        s->live_ = 0;
+
+        ++ slabs_;
+
+        return s;
+    }
+
+    void unmap(slab * s)
+    {
+        -- slabs_;
+
+        unmap_pages(s, slab_size_, slab_size_);
+    }
+
+
+    /** Size of the chunks. */
+    std::size_t const size_;
+
+    /** Offset of the first chunk in a slab. */
+    std::size_t const offset_;
+
+    /** Size and alignment of the slabs. */
+    std::size_t const slab_size_;
+
+    /** Alignment of the chunks. */
+    std::size_t const alignment_;
+
+    /** Chunks hold nodes. */
+    bool const nodes_;
+
+    /** Slabs with free chunks, some of them allocated. */
+    slab * avail_;
+
+    /** Slabs with all chunks free. */
+    slab * empty_;
+
+    /** Slabs with all chunks allocated. */
+    slab * full_;
+
+    /** Slabs obtained from the system. */
+    std::size_t slabs_;
+
+    /** Chunks allocated. */
+    std::size_t live_;
+
+    /** Chunks kept available by @c reserve() . */
+    std::size_t reserved_;
+
+    /** Next pool of all pools. */
+    slab_pool * next_pool_;
+
+    /** Enlisted in all pools. */
+    bool registered_;
+
+    /** Limited to the slabs obtained so far. */
+    bool fixed_;
+};
+
+
+/**
+    Objects too large for the pools, mapped on their own.
+*/
+
+struct large_objects
+{
+    /** Objects mapped. */
+    std::atomic<std::size_t> live_{0};
+
+    /** Bytes mapped. */
+    std::atomic<std::size_t> bytes_{0};
+
+
+    static large_objects & instance()
+    {
+        static BOOST_SMART_PTR_CONSTINIT large_objects l;
+
+        return l;
+    }
+
+    void add(std::size_t n)
+    {
+        live_.fetch_add(1, std::memory_order_relaxed);
+        bytes_.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    void remove(std::size_t n)
+    {
+        live_.fetch_sub(1, std::memory_order_relaxed);
+        bytes_.fetch_sub(n, std::memory_order_relaxed);
+    }
+};
+
+
+} // namespace detail
+
+} // namespace smart_ptr
+
+} // namespace boost
+
+
+#endif // #ifndef BOOST_DETAIL_SLAB_POOL_HPP_INCLUDED
@@ -0,0 +1,261 @@
+/**
+    \file
+    \brief Boost detail/slot_table.hpp header file.
+
+    Patent US11288049B2
+    'SOURCE TO SOURCE COMPILER, COMPILATION METHOD, AND
+    COMPUTER-READABLE MEDIUM FOR PREDICTABLE MEMORY MANAGEMENT'
+
+    Copyright (C) 2020-2026 Fornux LLC
+
+    Phil Bouchard, Founder & CEO
+    Fornux LLC
+    phil@fornux.com
+    3909 S Maryland Pkwy Ste 314 #638, Las Vegas, NV, 89119
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+
+#ifndef BOOST_DETAIL_SLOT_TABLE_HPP_INCLUDED
+#define BOOST_DETAIL_SLOT_TABLE_HPP_INCLUDED
+
+
+#include <new>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include <boost/config.hpp>
+#include <boost/throw_exception.hpp>
+
+#ifndef BOOST_DISABLE_THREADS
+#include <mutex>
+#endif
+
+
+#ifndef BOOST_SMART_PTR_HANDLE_CHUNKS
+/** Bound of the chunks of slots, thus of the nodes designated by a @c root_handle at once. */
+#define BOOST_SMART_PTR_HANDLE_CHUNKS 1024
+#endif
+
+
+namespace boost
+{
+
+
+#ifndef BOOST_DISABLE_THREADS
+static std::recursive_mutex & static_recursive_mutex();
+#endif
+
+
+namespace smart_ptr
+{
+
+namespace detail
+{
+
+
+/**
+    Table of the slots designating nodes by index for @c root_handle .
+
+    A node is given a slot the first time a handle is taken to it and gives it back when it is 
+    destroyed, which bumps the generation of the slot.  Handles record the generation they were 
+    taken at, so that those outliving the node no longer match.
+
+    Slots are allocated by chunks which are never moved nor freed, so that a slot is read without 
+    locking: its generation is loaded before and after its pointee object, seqlock-style, thus a 
+    read racing with the destruction of the node sees the bump.  Slot 0 is never given and stands 
+    for the null handle.
+*/
+
+class slot_table
+{
+public:
+    enum
+    {
+        /** Slots per chunk, as a power of 2. */
+        chunk_bits = 12,
+        chunk_size = 1 << chunk_bits,
+
+        /** Bound of the chunks. */
+        chunks = BOOST_SMART_PTR_HANDLE_CHUNKS
+    };
+
+    /** Slot of a node. */
+    struct slot
+    {
+        /** Pointee object of the node, or null if the slot is free. */
+        std::atomic<void *> data_{nullptr};
+
+        /** Bumped each time the node of the slot is destroyed. */
+        std::atomic<std::uint32_t> generation_{0};
+
+        /** Next free slot, under the global mutex. */
+        std::uint32_t next_ = 0;
+    };
+
+
+    /** Never destroyed, so that nodes can be destroyed in static destructors. */
+    static slot_table & instance()
+    {
+        static slot_table & r = * new slot_table;
+
+        return r;
+    }
+
+
+    /**
+        Current generation of slot @c i .
+    */
+
+    std::uint32_t generation(std::uint32_t i) const noexcept
+    {
+        return at(i).generation_.load(std::memory_order_acquire);
+    }
+
+
+    /**
+        Reads the pointee object of a slot unless its node was destroyed.
+
+        @param  i   Slot.
+        @param  g   Generation expected.
+        @param  p   Receives the pointee object.
+        @return     Whether slot @c i was still at generation @c g .
+    */
+
+    bool load(std::uint32_t i, std::uint32_t g, void * & p) const noexcept
+    {
+        slot const & s = at(i);
+
+        if (s.generation_.load(std::memory_order_acquire) != g)
+            return false;
+
+        p = s.data_.load(std::memory_order_relaxed);
+
+        // pairs with the fence of retire(): a cleared pointee object comes with the bump
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        return s.generation_.load(std::memory_order_relaxed) == g;
+    }
+
+
+    /**
+        Gives a slot to a node, unless it already has one.
+
+        @param  s   Slot of the node, 0 if none.
+        @param  p   Pointee object of the node.
+        @return     Slot of the node.
+    */
+
+    std::uint32_t assign(std::uint32_t & s, void * p)
+    {
+#ifndef BOOST_DISABLE_THREADS
+        std::scoped_lock guard(static_recursive_mutex());
+#endif
+
+        if (s)
+            return s;
+
+        if (! free_)
+            grow();
+
+        slot & e = get(free_);
+
+        s = free_;
+        free_ = e.next_;
+        e.data_.store(p, std::memory_order_release);
+
+        return s;
+    }
+
+
+    /**
+        Takes back the slot of a node being destroyed.
+
+        @param  i   Slot of the node.
+    */
+
+    void retire(std::uint32_t i) noexcept
+    {
+#ifndef BOOST_DISABLE_THREADS
+        std::scoped_lock guard(static_recursive_mutex());
+#endif
+
+        slot & e = get(i);
+
+        e.generation_.store(e.generation_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        e.data_.store(nullptr, std::memory_order_relaxed);
+        e.next_ = free_;
+        free_ = i;
+    }
+
+private:
+    slot_table()
+    : size_(0)
+    , free_(0)
+    , chunks_{}
+    {
+        // the null handle reads the first slot
+        grow();
+    }
+
+    slot const & at(std::uint32_t i) const noexcept
+    {
+        return chunks_[i >> chunk_bits].load(std::memory_order_acquire)[i & (chunk_size - 1)];
+    }
+
+    slot & get(std::uint32_t i)
+    {
+        return chunks_[i >> chunk_bits].load(std::memory_order_relaxed)[i & (chunk_size - 1)];
+    }
+
+    void grow()
+    {
+        if (size_ == chunks)
+            boost::throw_exception(std::bad_alloc());
+
+        slot * c = new slot[chunk_size];
+        std::uint32_t const b = std::uint32_t(size_) << chunk_bits;
+
+        // the first slot of all is kept for the null handle
+        for (std::uint32_t i = chunk_size; i > (size_ ? 0 : 1); -- i)
+        {
+            c[i - 1].next_ = free_;
+            free_ = b + i - 1;
+        }
+
+        chunks_[size_ ++].store(c, std::memory_order_release);
+    }
+
+
+    /** Chunks allocated. */
+    std::size_t size_;
+
+    /** First free slot, or 0. */
+    std::uint32_t free_;
+
+    /** Chunks of slots, published to the readers of their slots. */
+    std::atomic<slot *> chunks_[chunks];
+};
+
+
+} // namespace detail
+
+} // namespace smart_ptr
+
+} // namespace boost
+
+
+#endif // #ifndef BOOST_DETAIL_SLOT_TABLE_HPP_INCLUDED
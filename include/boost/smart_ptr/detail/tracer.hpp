@@ -0,0 +1,462 @@
+/**
+    \file
+    \brief Boost detail/tracer.hpp header file.
+
+    Patent US11288049B2
+    'SOURCE TO SOURCE COMPILER, COMPILATION METHOD, AND
+    COMPUTER-READABLE MEDIUM FOR PREDICTABLE MEMORY MANAGEMENT'
+
+    Copyright (C) 2020-2026 Fornux LLC
+
+    Phil Bouchard, Founder & CEO
+    Fornux LLC
+    phil@fornux.com
+    3909 S Maryland Pkwy Ste 314 #638, Las Vegas, NV, 89119
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+
+#ifndef BOOST_DETAIL_TRACER_HPP_INCLUDED
+#define BOOST_DETAIL_TRACER_HPP_INCLUDED
+
+
+#include <atomic>
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(BOOST_SMART_PTR_TRACE_TSC) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#endif
+
+#ifndef BOOST_DISABLE_THREADS
+#include <mutex>
+#endif
+
+
+namespace boost
+{
+
+
+/**
+    Event traced with @c BOOST_SMART_PTR_TRACE .
+*/
+
+enum class trace_kind : std::uint8_t
+{
+    /** Node allocated; the size is its footprint. */
+    allocate,
+
+    /** Node deallocated; the size is its footprint. */
+    free,
+
+    /** Reference to a node copied by @c root_core::share() . */
+    share,
+
+    /** Reference to a node dropped by @c root_core::reset() . */
+    reset,
+
+    /** @c node_proxy constructed; the size is its depth. */
+    proxy_construct,
+
+    /** @c node_proxy destructed. */
+    proxy_destruct,
+
+    /** @c node_proxy::reset() started. */
+    reset_begin,
+
+    /** Pointers of the @c node_proxy detached from their nodes; the size is their number. */
+    reset_detached,
+
+    /** Nodes destroyed; the size is their number. */
+    reset_destroyed,
+
+    /** Region released, ending @c node_proxy::reset() . */
+    reset_released
+};
+
+
+/**
+    Record of an event, written as is by @c trace_file .
+*/
+
+struct trace_event
+{
+    /** Ticks of @c trace_clock() . */
+    std::uint64_t time_;
+
+    /** Node or @c node_proxy . */
+    std::uint64_t address_;
+
+    std::uint64_t size_;
+
+    /** Sequence number of the thread, from 1. */
+    std::uint32_t thread_;
+
+    trace_kind kind_;
+
+    std::uint8_t reserved_[3];
+};
+
+static_assert(sizeof(trace_event) == 32, "trace_event is written as is");
+
+
+/**
+    Destination of the events.
+
+    @c write() is given the events of one thread at a time, possibly from several threads but never
+    concurrently.
+*/
+
+class trace_sink
+{
+public:
+    virtual ~trace_sink() = default;
+
+    virtual void write(trace_event const * p, std::size_t n) = 0;
+};
+
+
+/**
+    Timestamp of the events: the time stamp counter with @c BOOST_SMART_PTR_TRACE_TSC on x86, or 
+    else nanoseconds of @c std::chrono::steady_clock .
+*/
+
+inline std::uint64_t trace_clock() noexcept
+{
+#if defined(BOOST_SMART_PTR_TRACE_TSC) && (defined(__x86_64__) || defined(__i386__))
+    return __rdtsc();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+
+/**
+    Ticks of @c trace_clock() per microsecond, calibrated once for the time stamp counter.
+*/
+
+inline double trace_frequency()
+{
+#if defined(BOOST_SMART_PTR_TRACE_TSC) && (defined(__x86_64__) || defined(__i386__))
+    static double const f = []
+    {
+        typedef std::chrono::steady_clock clock;
+
+        clock::time_point const s = clock::now();
+        std::uint64_t const t = trace_clock();
+
+        while (clock::now() - s < std::chrono::milliseconds(10))
+            ;
+
+        std::uint64_t const u = trace_clock();
+
+        return (u - t) / double(std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - s).count()) * 1000;
+    }();
+
+    return f;
+#else
+    return 1000;
+#endif
+}
+
+
+namespace smart_ptr
+{
+
+namespace detail
+{
+
+
+/**
+    Buffer of the events of a thread.
+
+    Written by its thread only and drained under the lock of the @c tracer , thus the thread does 
+    not lock unless its buffer fills up.
+*/
+
+class trace_buffer
+{
+public:
+    enum
+    {
+        /** Events held until the next flush. */
+        capacity = 1024
+    };
+
+
+    explicit trace_buffer(std::uint32_t t)
+    : thread_(t)
+    {
+    }
+
+
+    /**
+        Records an event.
+
+        @pre        The buffer is not full.
+        @return     Whether the buffer is now full.
+    */
+
+    bool push(trace_kind k, void const * p, std::uint64_t n)
+    {
+        std::size_t const h = head_.load(std::memory_order_relaxed);
+        trace_event & e = events_[h % capacity];
+
+        e.time_ = trace_clock();
+        e.address_ = reinterpret_cast<std::uintptr_t>(p);
+        e.size_ = n;
+        e.thread_ = thread_;
+        e.kind_ = k;
+
+        head_.store(h + 1, std::memory_order_release);
+
+        return h + 1 - tail_.load(std::memory_order_acquire) == capacity;
+    }
+
+
+    /**
+        Writes the events recorded so far to a sink, or discards them if there is none.
+    */
+
+    void drain(trace_sink * s)
+    {
+        std::size_t t = tail_.load(std::memory_order_relaxed);
+        std::size_t const h = head_.load(std::memory_order_acquire);
+
+        while (s && t != h)
+        {
+            // contiguous up to the end of the ring
+            std::size_t const n = std::min<std::size_t>(h - t, capacity - t % capacity);
+
+            s->write(events_ + t % capacity, n);
+            t += n;
+        }
+
+        tail_.store(h, std::memory_order_release);
+    }
+
+
+    /** Next buffer of all buffers. */
+    trace_buffer * next_ = nullptr;
+
+private:
+    std::uint32_t const thread_;
+
+    trace_event events_[capacity] = {};
+
+    std::atomic<std::size_t> head_{0};
+    std::atomic<std::size_t> tail_{0};
+};
+
+
+/**
+    Collects the buffers of all threads and writes their events to the current sink.
+*/
+
+class tracer
+{
+public:
+    static tracer & instance()
+    {
+        static tracer t;
+
+        return t;
+    }
+
+
+    /**
+        Records an event from the calling thread if a sink is set.
+    */
+
+    static void trace(trace_kind k, void const * p, std::uint64_t n = 0)
+    {
+        if (! sink().load(std::memory_order_acquire))
+            return;
+
+        if (trace_buffer * b = buffer())
+            if (b->push(k, p, n))
+                instance().flush(b);
+    }
+
+
+    /**
+        Writes the events recorded so far to the current sink and sets the next one.
+    */
+
+    void open(trace_sink * s)
+    {
+#ifndef BOOST_DISABLE_THREADS
+        std::scoped_lock guard(mutex_);
+#endif
+
+        flush_locked();
+
+        sink().store(s, std::memory_order_release);
+    }
+
+
+    /**
+        Writes the events recorded so far.
+    */
+
+    void flush()
+    {
+#ifndef BOOST_DISABLE_THREADS
+        std::scoped_lock guard(mutex_);
+#endif
+
+        flush_locked();
+    }
+
+
+    /** Current sink, or null when tracing is off. */
+    static std::atomic<trace_sink *> & sink()
+    {
+        static std::atomic<trace_sink *> s{nullptr};
+
+        return s;
+    }
+
+private:
+    tracer() = default;
+
+    ~tracer()
+    {
+        // the sink may be gone already: events not flushed by now are lost
+        destroyed() = true;
+    }
+
+
+    static bool & destroyed()
+    {
+        static bool b = false;
+
+        return b;
+    }
+
+    /** Buffer of the calling thread, written to the sink when the thread exits. */
+    static trace_buffer * buffer()
+    {
+        struct holder
+        {
+            trace_buffer * p = nullptr;
+
+            ~holder()
+            {
+                if (p && ! destroyed())
+                    instance().close(p);
+            }
+        };
+
+        static thread_local holder h;
+
+        if (! h.p && ! destroyed())
+        {
+            tracer & t = instance();
+
+#ifndef BOOST_DISABLE_THREADS
+            std::scoped_lock guard(t.mutex_);
+#endif
+
+            h.p = new trace_buffer(++ t.threads_);
+            h.p->next_ = t.buffers_;
+            t.buffers_ = h.p;
+        }
+
+        return h.p;
+    }
+
+    void flush(trace_buffer * b)
+    {
+#ifndef BOOST_DISABLE_THREADS
+        std::scoped_lock guard(mutex_);
+#endif
+
+        b->drain(sink().load(std::memory_order_acquire));
+    }
+
+    void close(trace_buffer * b)
+    {
+#ifndef BOOST_DISABLE_THREADS
+        std::scoped_lock guard(mutex_);
+#endif
+
+        b->drain(sink().load(std::memory_order_acquire));
+
+        for (trace_buffer ** p = & buffers_; * p; p = & (* p)->next_)
+            if (* p == b)
+            {
+                * p = b->next_;
+
+                break;
+            }
+
+        delete b;
+    }
+
+    void flush_locked()
+    {
+        trace_sink * s = sink().load(std::memory_order_acquire);
+
+        for (trace_buffer * p = buffers_; p; p = p->next_)
+            p->drain(s);
+    }
+
+
+    /** Buffers of all threads alive. */
+    trace_buffer * buffers_ = nullptr;
+
+    /** Threads numbered so far. */
+    std::uint32_t threads_ = 0;
+
+#ifndef BOOST_DISABLE_THREADS
+    std::mutex mutex_;
+#endif
+};
+
+
+} // namespace detail
+
+} // namespace smart_ptr
+
+
+/**
+    Sends the events traced with @c BOOST_SMART_PTR_TRACE to a sink from now on, after writing 
+    those recorded so far to the previous one.
+
+    @param  s   Sink outliving the tracing, or null to stop tracing.
+*/
+
+inline void trace_to(trace_sink * s)
+{
+    smart_ptr::detail::tracer::instance().open(s);
+}
+
+
+/**
+    Writes the events recorded so far by all threads to the current sink.
+*/
+
+inline void flush_trace()
+{
+    smart_ptr::detail::tracer::instance().flush();
+}
+
+
+} // namespace boost
+
+
+#endif // #ifndef BOOST_DETAIL_TRACER_HPP_INCLUDED
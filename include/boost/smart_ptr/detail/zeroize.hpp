@@ -0,0 +1,92 @@
+/**
+    \file
+    \brief Boost detail/zeroize.hpp header file.
+
+    Patent US11288049B2
+    'SOURCE TO SOURCE COMPILER, COMPILATION METHOD, AND
+    COMPUTER-READABLE MEDIUM FOR PREDICTABLE MEMORY MANAGEMENT'
+
+    Copyright (C) 2020-2026 Fornux LLC
+
+    Phil Bouchard, Founder & CEO
+    Fornux LLC
+    phil@fornux.com
+    3909 S Maryland Pkwy Ste 314 #638, Las Vegas, NV, 89119
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+
+#ifndef BOOST_DETAIL_ZEROIZE_HPP_INCLUDED
+#define BOOST_DETAIL_ZEROIZE_HPP_INCLUDED
+
+
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+
+namespace boost
+{
+
+namespace smart_ptr
+{
+
+namespace detail
+{
+
+
+/**
+    Overwrites memory with zeros.
+
+    Relies on the vectorized @c memset of the C library but, unlike a plain call, is never elided 
+    by the compiler even when the memory is freed right after.
+
+    @param  p   Address of the memory.
+    @param  n   Size in bytes.
+*/
+
+inline void zeroize(void * p, std::size_t n) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    std::memset(p, 0, n);
+
+    // the memory is an input of the statement thus the stores are not dead
+    __asm__ __volatile__ ("" : : "r"(p) : "memory");
+#else
+    // a call through a volatile pointer cannot be resolved, hence removed, at compile time
+    static void * (* const volatile set)(void *, int, std::size_t) = & std::memset;
+
+    set(p, 0, n);
+#endif
+}
+
+
+/**
+    Tells whether deallocations through @c A already zeroize the memory.
+*/
+
+template <typename A>
+    struct is_zeroizing : std::false_type
+    {
+    };
+
+
+} // namespace detail
+
+} // namespace smart_ptr
+
+} // namespace boost
+
+
+#endif // #ifndef BOOST_DETAIL_ZEROIZE_HPP_INCLUDED
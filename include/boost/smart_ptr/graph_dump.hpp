@@ -0,0 +1,227 @@
+/*!
+    \file
+    \brief Boost graph_dump.hpp header file.
+
+    Patent US11288049B2
+    'SOURCE TO SOURCE COMPILER, COMPILATION METHOD, AND
+    COMPUTER-READABLE MEDIUM FOR PREDICTABLE MEMORY MANAGEMENT'
+
+    Copyright (C) 2020-2026 Fornux LLC
+
+    Phil Bouchard, Founder & CEO
+    Fornux LLC
+    phil@fornux.com
+    3909 S Maryland Pkwy Ste 314 #638, Las Vegas, NV, 89119
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef BOOST_GRAPH_DUMP_INCLUDED
+#define BOOST_GRAPH_DUMP_INCLUDED
+
+
+#include <map>
+#include <string>
+#include <vector>
+#include <utility>
+#include <ostream>
+#include <typeindex>
+#include <algorithm>
+
+#include <boost/core/demangle.hpp>
+#include <boost/smart_ptr/root_ptr.hpp>
+#include <boost/smart_ptr/detail/quote.hpp>
+
+
+namespace boost
+{
+
+
+/**
+    Format of a graph dump.
+*/
+
+enum class graph_format
+{
+    /** Graphviz. */
+    dot,
+
+    /** One JSON object per line: the @c node_proxy , then each node, then each edge. */
+    ndjson
+};
+
+
+namespace smart_ptr
+{
+
+namespace detail
+{
+
+
+/**
+    Writes the object graph of a @c node_proxy as it walks it.
+*/
+
+class graph_writer
+{
+public:
+    graph_writer(std::ostream & out, graph_format f)
+    : out_(out)
+    , format_(f)
+    {
+    }
+
+
+    void proxy(node_proxy const & x)
+    {
+        if (format_ == graph_format::dot)
+        {
+            out_ << "digraph root_ptr {\n  node [shape=box];\n  \"" << & x << "\" [shape=ellipse, label=";
+            quote(out_, x.function_) << "];\n";
+        }
+        else
+        {
+            out_ << "{\"proxy\":\"" << & x << "\",\"function\":";
+            quote(out_, x.function_) << ",\"file\":";
+            quote(out_, x.file_) << ",\"line\":" << x.line_ << "}\n";
+        }
+    }
+
+    void node(void const * a, node_base * p)
+    {
+        std::string const & t = name(p);
+
+        if (format_ == graph_format::dot)
+        {
+            out_ << "  \"" << a << "\" [label=";
+            quote(out_, (t + " (" + std::to_string(p->size_bytes()) + " B)").c_str()) << "];\n";
+        }
+        else
+        {
+            out_ << "{\"node\":\"" << a << "\",\"type\":";
+            quote(out_, t.c_str()) << ",\"size\":" << p->size_bytes() << ",\"elements\":" << p->size() << "}\n";
+        }
+    }
+
+    void edge(void const * from, void const * to)
+    {
+        if (format_ == graph_format::dot)
+            out_ << "  \"" << from << "\" -> \"" << to << "\";\n";
+        else
+            out_ << "{\"edge\":[\"" << from << "\",\"" << to << "\"]}\n";
+    }
+
+    void end()
+    {
+        if (format_ == graph_format::dot)
+            out_ << "}\n";
+
+        out_.flush();
+    }
+
+private:
+    /** Demangled once per type. */
+    std::string const & name(node_base const * p)
+    {
+        std::type_index const i(typeid(* p));
+        std::map<std::type_index, std::string>::iterator j = names_.find(i);
+
+        if (j == names_.end())
+            j = names_.emplace(i, core::demangle(i.name())).first;
+
+        return j->second;
+    }
+
+
+    std::ostream & out_;
+    graph_format const format_;
+    std::map<std::type_index, std::string> names_;
+};
+
+
+} // namespace detail
+
+} // namespace smart_ptr
+
+
+/**
+    Writes the object graph of a @c node_proxy : its nodes, named after the address of their 
+    pointee object, with their type and size, and an edge for each pointer of the @c node_proxy to
+    a node.
+
+    An edge starts from the node whose pointee object holds the pointer, or else from the 
+    @c node_proxy itself for pointers held elsewhere, such as on the stack or in containers using
+    their own storage.
+
+    The distinct nodes are first gathered and sorted by the address of their pointee object, 16 
+    bytes each, so that the node holding a pointer is found by a binary search.  The nodes are 
+    written next, then the edges as the pointers are walked, in O(p log n) time for p pointers to 
+    n nodes.  The global mutex is held throughout.
+
+    @param  x       Owner of the graph.
+    @param  out     Stream written.
+    @param  f       Format.
+*/
+
+inline void dump_graph(node_proxy const & x, std::ostream & out, graph_format f = graph_format::dot)
+{
+    using namespace smart_ptr::detail;
+
+#ifndef BOOST_DISABLE_THREADS
+    std::scoped_lock guard(static_recursive_mutex());
+#endif
+
+    typedef intrusive_list::iterator<root_core, & root_core::root_tag_> iterator;
+
+    graph_writer w(out, f);
+
+    w.proxy(x);
+
+    // pointee objects by address, each written once
+    std::vector<std::pair<char const *, node_base *>> n;
+
+    for (iterator p = x.root_set_.begin(); p != x.root_set_.end(); ++ p)
+        if (node_base * i = p->po_)
+            n.emplace_back(static_cast<char const *>(i->data()), i);
+
+    std::sort(n.begin(), n.end());
+    n.erase(std::unique(n.begin(), n.end()), n.end());
+
+    for (std::pair<char const *, node_base *> const & i : n)
+        w.node(i.first, i.second);
+
+    for (iterator p = x.root_set_.begin(); p != x.root_set_.end(); ++ p)
+    {
+        node_base * i = p->po_;
+
+        if (! i)
+            continue;
+
+        // last pointee object starting at or before the pointer
+        char const * const a = reinterpret_cast<char const *>(& * p);
+        std::vector<std::pair<char const *, node_base *>>::const_iterator j = std::upper_bound(n.cbegin(), n.cend(), std::make_pair(a, static_cast<node_base *>(nullptr)), [] (std::pair<char const *, node_base *> const & u, std::pair<char const *, node_base *> const & v) { return u.first < v.first; });
+
+        if (j != n.cbegin() && a < (-- j)->first + j->second->size_bytes())
+            w.edge(j->first, i->data());
+        else
+            w.edge(& x, i->data());
+    }
+
+    w.end();
+}
+
+
+} // namespace boost
+
+
+#endif // #ifndef BOOST_GRAPH_DUMP_INCLUDED
@@ -0,0 +1,228 @@
+/*!
+    \file
+    \brief Boost heap_profile.hpp header file.
+
+    Patent US11288049B2
+    'SOURCE TO SOURCE COMPILER, COMPILATION METHOD, AND
+    COMPUTER-READABLE MEDIUM FOR PREDICTABLE MEMORY MANAGEMENT'
+
+    Copyright (C) 2020-2026 Fornux LLC
+
+    Phil Bouchard, Founder & CEO
+    Fornux LLC
+    phil@fornux.com
+    3909 S Maryland Pkwy Ste 314 #638, Las Vegas, NV, 89119
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef BOOST_HEAP_PROFILE_INCLUDED
+#define BOOST_HEAP_PROFILE_INCLUDED
+
+
+#include <map>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <ostream>
+
+#include <boost/smart_ptr/root_ptr.hpp>
+#include <boost/smart_ptr/detail/heap_site.hpp>
+
+
+namespace boost
+{
+
+
+/**
+    Snapshot of the live nodes per @c node_proxy call site, including the chain of its parents.
+
+    Sites are only recorded with @c BOOST_SMART_PTR_HEAP_PROFILE defined; otherwise the snapshot 
+    is empty.
+*/
+
+class heap_profile
+{
+public:
+    typedef smart_ptr::detail::heap_site heap_site;
+
+    /** Live nodes of a site. */
+    struct site
+    {
+        /** Innermost call site first. */
+        std::vector<heap_site const *> frames_;
+
+        std::size_t count_;
+        std::size_t bytes_;
+    };
+
+
+    /**
+        Takes the snapshot.
+    */
+
+    heap_profile()
+    {
+        heap_site::for_each([this] (heap_site const & s)
+        {
+            std::size_t const n = s.count_.load(std::memory_order_relaxed);
+
+            if (! n)
+                return;
+
+            sites_.push_back(site{{}, n, s.bytes_.load(std::memory_order_relaxed)});
+
+            for (heap_site const * p = & s; p; p = p->parent_)
+                sites_.back().frames_.push_back(p);
+        });
+    }
+
+
+    std::vector<site> const & sites() const
+    {
+        return sites_;
+    }
+
+
+    /**
+        Writes the live bytes in the folded stack format of flame graphs: outermost site first, 
+        separated by semicolons.
+    */
+
+    std::ostream & folded(std::ostream & out) const
+    {
+        for (site const & s : sites_)
+        {
+            for (std::size_t i = s.frames_.size(); i > 0; -- i)
+                out << s.frames_[i - 1]->function_ << " (" << s.frames_[i - 1]->file_ << ':' << s.frames_[i - 1]->line_ << ')' << (i > 1 ? ";" : " ");
+
+            out << s.bytes_ << '\n';
+        }
+
+        return out;
+    }
+
+
+    /**
+        Writes an uncompressed @c profile.proto message readable by pprof, with the live objects and
+        bytes of each site.
+    */
+
+    std::ostream & pprof(std::ostream & out) const
+    {
+        std::string p, m;
+        std::map<std::string, std::uint64_t> strings;
+        std::map<heap_site const *, std::uint64_t> locations;
+
+        auto string = [& strings] (std::string const & s)
+        {
+            auto i = strings.emplace(s, strings.size());
+
+            return i.first->second;
+        };
+
+        string("");
+
+        // sample_type
+        for (auto t : {std::make_pair("inuse_objects", "count"), std::make_pair("inuse_space", "bytes")})
+        {
+            m.clear();
+            field(m, 1, string(t.first));
+            field(m, 2, string(t.second));
+            field(p, 1, m);
+        }
+
+        for (site const & s : sites_)
+        {
+            std::string l, v;
+
+            for (heap_site const * f : s.frames_)
+            {
+                auto i = locations.emplace(f, locations.size() + 1);
+
+                varint(l, i.first->second);
+
+                if (! i.second)
+                    continue;
+
+                // function and location of the same id
+                m.clear();
+                field(m, 1, i.first->second);
+                field(m, 2, string(f->function_));
+                field(m, 3, string(f->function_));
+                field(m, 4, string(f->file_));
+                field(p, 5, m);
+
+                std::string n;
+
+                field(n, 1, i.first->second);
+                field(n, 2, f->line_);
+
+                m.clear();
+                field(m, 1, i.first->second);
+                field(m, 4, n);
+                field(p, 4, m);
+            }
+
+            varint(v, s.count_);
+            varint(v, s.bytes_);
+
+            // sample with packed location ids and values
+            m.clear();
+            field(m, 1, l);
+            field(m, 2, v);
+            field(p, 2, m);
+        }
+
+        std::vector<std::string const *> t(strings.size());
+
+        for (auto const & i : strings)
+            t[i.second] = & i.first;
+
+        for (std::string const * s : t)
+            field(p, 6, * s);
+
+        return out.write(p.data(), p.size());
+    }
+
+private:
+    static void varint(std::string & b, std::uint64_t n)
+    {
+        for (; n >= 0x80; n >>= 7)
+            b += char(n | 0x80);
+
+        b += char(n);
+    }
+
+    static void field(std::string & b, unsigned k, std::uint64_t n)
+    {
+        varint(b, k << 3);
+        varint(b, n);
+    }
+
+    static void field(std::string & b, unsigned k, std::string const & s)
+    {
+        varint(b, k << 3 | 2);
+        varint(b, s.size());
+        b += s;
+    }
+
+
+    std::vector<site> sites_;
+};
+
+
+} // namespace boost
+
+
+#endif // #ifndef BOOST_HEAP_PROFILE_INCLUDED
@@ -0,0 +1,169 @@
+/*!
+    \file
+    \brief Boost lifetime_profile.hpp header file.
+
+    Patent US11288049B2
+    'SOURCE TO SOURCE COMPILER, COMPILATION METHOD, AND
+    COMPUTER-READABLE MEDIUM FOR PREDICTABLE MEMORY MANAGEMENT'
+
+    Copyright (C) 2020-2026 Fornux LLC
+
+    Phil Bouchard, Founder & CEO
+    Fornux LLC
+    phil@fornux.com
+    3909 S Maryland Pkwy Ste 314 #638, Las Vegas, NV, 89119
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef BOOST_LIFETIME_PROFILE_INCLUDED
+#define BOOST_LIFETIME_PROFILE_INCLUDED
+
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <ostream>
+
+#include <boost/core/demangle.hpp>
+#include <boost/smart_ptr/root_ptr.hpp>
+#include <boost/smart_ptr/detail/lifetime.hpp>
+
+
+namespace boost
+{
+
+
+/**
+    Snapshot of the lifetimes of the nodes reclaimed so far, per node type.
+
+    Lifetimes are only recorded with @c BOOST_SMART_PTR_LIFETIME defined; otherwise the snapshot 
+    is empty.  They are measured both in allocation ticks, the number of nodes constructed in the 
+    meantime, and in nanoseconds, and split by how the nodes were reclaimed.
+*/
+
+class lifetime_profile
+{
+public:
+    typedef smart_ptr::detail::lifetime_histogram lifetime_histogram;
+
+    /** Log-scale histogram copied from the live one. */
+    struct histogram
+    {
+        std::uint64_t count_;
+        std::uint64_t buckets_[lifetime_histogram::buckets];
+
+
+        /**
+            Upper bound of a percentile, exact to a factor of two.
+
+            @param  p   Percentile, in ]0, 100].
+            @return     Smallest power of two minus one that at least @c p percent of the lifetimes 
+                        do not exceed, or 0 if there are none.
+        */
+
+        std::uint64_t percentile(double p) const
+        {
+            if (! count_)
+                return 0;
+
+            std::uint64_t n = 0;
+
+            for (std::size_t k = 0; k < lifetime_histogram::buckets; ++ k)
+                if ((n += buckets_[k]) * 100.0 >= p * count_)
+                    return k < 64 ? (std::uint64_t(1) << k) - 1 : std::uint64_t(-1);
+
+            return std::uint64_t(-1);
+        }
+    };
+
+    /** Lifetimes of a node type, indexed by @c lifetime_end . */
+    struct type
+    {
+        /** Demangled name of the node type. */
+        std::string name_;
+
+        histogram ticks_[2];
+        histogram nanos_[2];
+    };
+
+
+    /**
+        Takes the snapshot.
+    */
+
+    lifetime_profile()
+    {
+        smart_ptr::detail::lifetime_registry::instance().for_each([this] (lifetime_histogram const & h)
+        {
+            types_.push_back(type{core::demangle(h.type_.name()), {}, {}});
+
+            for (std::size_t i = 0; i < 2; ++ i)
+            {
+                copy(h.ticks_[i], types_.back().ticks_[i]);
+                copy(h.nanos_[i], types_.back().nanos_[i]);
+            }
+        });
+    }
+
+
+    std::vector<type> const & types() const
+    {
+        return types_;
+    }
+
+
+    /**
+        Writes the count, median, 90th and 99th percentiles of each type and reclamation, in 
+        allocation ticks and nanoseconds.
+    */
+
+    std::ostream & text(std::ostream & out) const
+    {
+        static char const * const ends[] = {"refcount", "reset"};
+
+        for (type const & t : types_)
+        {
+            out << t.name_ << '\n';
+
+            for (std::size_t i = 0; i < 2; ++ i)
+            {
+                if (! t.ticks_[i].count_)
+                    continue;
+
+                out << "  " << ends[i] << ": " << t.ticks_[i].count_ << " nodes, ticks p50 " << t.ticks_[i].percentile(50) << " p90 " << t.ticks_[i].percentile(90) << " p99 " << t.ticks_[i].percentile(99);
+                out << ", ns p50 " << t.nanos_[i].percentile(50) << " p90 " << t.nanos_[i].percentile(90) << " p99 " << t.nanos_[i].percentile(99) << '\n';
+            }
+        }
+
+        return out;
+    }
+
+private:
+    static void copy(std::atomic<std::uint64_t> const (& s)[lifetime_histogram::buckets], histogram & h)
+    {
+        h.count_ = 0;
+
+        for (std::size_t k = 0; k < lifetime_histogram::buckets; ++ k)
+            h.count_ += h.buckets_[k] = s[k].load(std::memory_order_relaxed);
+    }
+
+
+    std::vector<type> types_;
+};
+
+
+} // namespace boost
+
+
+#endif // #ifndef BOOST_LIFETIME_PROFILE_INCLUDED
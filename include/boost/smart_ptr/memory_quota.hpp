@@ -0,0 +1,271 @@
+/*!
+    \file
+    \brief Boost memory_quota.hpp header file.
+
+    Patent US11288049B2
+    'SOURCE TO SOURCE COMPILER, COMPILATION METHOD, AND
+    COMPUTER-READABLE MEDIUM FOR PREDICTABLE MEMORY MANAGEMENT'
+
+    Copyright (C) 2020-2026 Fornux LLC
+
+    Phil Bouchard, Founder & CEO
+    Fornux LLC
+    phil@fornux.com
+    3909 S Maryland Pkwy Ste 314 #638, Las Vegas, NV, 89119
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef BOOST_MEMORY_QUOTA_INCLUDED
+#define BOOST_MEMORY_QUOTA_INCLUDED
+
+
+#include <new>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+
+#include <boost/throw_exception.hpp>
+
+
+namespace boost
+{
+
+
+/**
+    Allocation beyond a memory quota.
+*/
+
+class quota_exceeded : public std::bad_alloc
+{
+public:
+    char const * what() const noexcept override
+    {
+        return "memory quota exceeded";
+    }
+};
+
+
+/**
+    Byte and object limits shared by the @c node_proxy it is given to.
+
+    Accounting is a couple of relaxed atomic operations per allocation and deallocation.  Crossing 
+    the high watermark upwards and then the low watermark downwards calls the callbacks once each, 
+    so that load can be shed before the limit is reached.
+
+    @note Callbacks are called from the thread allocating or freeing, possibly with the global 
+    mutex held.
+*/
+
+class memory_quota
+{
+public:
+    typedef std::function<void (memory_quota &)> callback;
+
+
+    /**
+        Initialization.
+
+        @param  bytes   Maximum number of bytes.
+        @param  objects Maximum number of objects.
+    */
+
+    explicit memory_quota(std::size_t bytes = std::size_t(-1), std::size_t objects = std::size_t(-1))
+    : max_bytes_(bytes)
+    , max_objects_(objects)
+    , high_(std::size_t(-1))
+    , low_(0)
+    , bytes_(0)
+    , objects_(0)
+    , above_(false)
+    {
+    }
+
+    memory_quota(memory_quota const &) = delete;
+
+
+    /**
+        Sets the watermarks in bytes, before any allocation.
+
+        @param  high    Threshold calling @c on_high when reached.
+        @param  low     Threshold calling @c on_low when reached after @c on_high .
+        @param  on_high Callback.
+        @param  on_low  Callback.
+    */
+
+    void watermarks(std::size_t high, std::size_t low, callback on_high, callback on_low = callback())
+    {
+        high_ = high;
+        low_ = low;
+        on_high_ = std::move(on_high);
+        on_low_ = std::move(on_low);
+    }
+
+
+    /**
+        Accounts for an allocation or throws @c quota_exceeded if it goes beyond either limit.
+
+        @param  n   Bytes.
+        @param  k   Objects.
+    */
+
+    void charge(std::size_t n, std::size_t k = 1)
+    {
+        std::size_t const b = bytes_.fetch_add(n, std::memory_order_relaxed) + n;
+        std::size_t const o = objects_.fetch_add(k, std::memory_order_relaxed) + k;
+
+        if (b > max_bytes_ || o > max_objects_)
+        {
+            bytes_.fetch_sub(n, std::memory_order_relaxed);
+            objects_.fetch_sub(k, std::memory_order_relaxed);
+
+            boost::throw_exception(quota_exceeded());
+        }
+
+        if (b >= high_ && ! above_.load(std::memory_order_relaxed) && ! above_.exchange(true) && on_high_)
+            on_high_(* this);
+    }
+
+
+    /**
+        Accounts for a deallocation.
+
+        @param  n   Bytes.
+        @param  k   Objects.
+    */
+
+    void credit(std::size_t n, std::size_t k = 1) noexcept
+    {
+        std::size_t const b = bytes_.fetch_sub(n, std::memory_order_relaxed) - n;
+
+        objects_.fetch_sub(k, std::memory_order_relaxed);
+
+        if (b <= low_ && above_.load(std::memory_order_relaxed) && above_.exchange(false) && on_low_)
+            on_low_(* this);
+    }
+
+
+    /** Bytes in use. */
+    std::size_t bytes() const
+    {
+        return bytes_.load(std::memory_order_relaxed);
+    }
+
+    /** Objects in use. */
+    std::size_t objects() const
+    {
+        return objects_.load(std::memory_order_relaxed);
+    }
+
+    /** Maximum number of bytes. */
+    std::size_t max_bytes() const
+    {
+        return max_bytes_;
+    }
+
+    /** Maximum number of objects. */
+    std::size_t max_objects() const
+    {
+        return max_objects_;
+    }
+
+private:
+    std::size_t const max_bytes_;
+    std::size_t const max_objects_;
+
+    /** Watermarks in bytes. */
+    std::size_t high_, low_;
+
+    std::atomic<std::size_t> bytes_;
+    std::atomic<std::size_t> objects_;
+
+    /** Set between the high and the low watermarks. */
+    std::atomic<bool> above_;
+
+    callback on_high_, on_low_;
+};
+
+
+namespace smart_ptr
+{
+
+namespace detail
+{
+
+
+/**
+    Tells whether @c A charges the quota of its @c node_proxy by itself.
+*/
+
+template <typename A>
+    struct charges_quota : std::false_type
+    {
+    };
+
+
+/**
+    Charges a quota for the duration of an allocation, unless committed.
+*/
+
+class quota_guard
+{
+public:
+    quota_guard(memory_quota * q, std::size_t n, std::size_t k = 1)
+    : q_(q)
+    , n_(n)
+    , k_(k)
+    {
+        if (q_)
+            q_->charge(n_, k_);
+    }
+
+    quota_guard(quota_guard const &) = delete;
+
+    ~quota_guard()
+    {
+        if (q_)
+            q_->credit(n_, k_);
+    }
+
+    /**
+        Keeps the charge once the allocation succeeded.
+
+        @return     Quota charged, to be credited by the owner of the memory.
+    */
+
+    memory_quota * commit()
+    {
+        memory_quota * q = q_;
+
+        q_ = nullptr;
+
+        return q;
+    }
+
+private:
+    memory_quota * q_;
+    std::size_t const n_;
+    std::size_t const k_;
+};
+
+
+} // namespace detail
+
+} // namespace smart_ptr
+
+
+} // namespace boost
+
+
+#endif // #ifndef BOOST_MEMORY_QUOTA_INCLUDED
@@ -0,0 +1,271 @@
+/*!
+    \file
+    \brief Boost memory_report.hpp header file.
+
+    Patent US11288049B2
+    'SOURCE TO SOURCE COMPILER, COMPILATION METHOD, AND
+    COMPUTER-READABLE MEDIUM FOR PREDICTABLE MEMORY MANAGEMENT'
+
+    Copyright (C) 2020-2026 Fornux LLC
+
+    Phil Bouchard, Founder & CEO
+    Fornux LLC
+    phil@fornux.com
+    3909 S Maryland Pkwy Ste 314 #638, Las Vegas, NV, 89119
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef BOOST_MEMORY_REPORT_INCLUDED
+#define BOOST_MEMORY_REPORT_INCLUDED
+
+
+#include <map>
+#include <string>
+#include <vector>
+#include <ostream>
+#include <typeindex>
+
+#include <boost/core/demangle.hpp>
+#include <boost/smart_ptr/root_ptr.hpp>
+#include <boost/smart_ptr/detail/quote.hpp>
+
+
+namespace boost
+{
+
+
+/**
+    Snapshot of the memory held by the slab pools, the large objects and the regions of some 
+    @c node_proxy .
+
+    Tells the bytes of pointee objects apart from the bytes lost to node headers, free chunks, 
+    empty slabs and unused region space.
+
+    @note Taken under the global mutex; the pointee objects of nodes in the pools must not be 
+    under construction meanwhile since the nodes are inspected through their virtual functions.  
+    Nodes in quarantine are only counted, their virtual table being poisoned.
+*/
+
+struct memory_report
+{
+    /** Slab pool of a size class. */
+    struct pool
+    {
+        std::size_t chunk_size_;
+        std::size_t alignment_;
+        std::size_t slab_size_;
+        std::size_t slabs_;
+
+        /** Chunks allocated. */
+        std::size_t live_;
+
+        /** Chunks free in slabs partially allocated. */
+        std::size_t free_;
+
+        /** Slabs with all chunks free, not yet returned to the system. */
+        std::size_t empty_;
+
+        /** Chunks allocated but holding nodes in quarantine, counted in @c live_ . */
+        std::size_t quarantined_;
+
+        /** Chunks hold nodes. */
+        bool nodes_;
+    };
+
+    /** Nodes of a type. */
+    struct type
+    {
+        std::string name_;
+        std::size_t chunk_size_;
+        std::size_t live_;
+
+        /** Bytes of the pointee objects, as given by @c node_base::size_bytes() . */
+        std::size_t payload_;
+
+        /** Bytes of the chunks not holding pointee objects. */
+        std::size_t header_;
+    };
+
+    /** Region of a @c node_proxy . */
+    struct region
+    {
+        char const * file_;
+        char const * function_;
+        unsigned line_;
+
+        /** Bytes obtained from the system. */
+        std::size_t size_;
+
+        /** Bytes left at the end of the current chunk. */
+        std::size_t tail_;
+
+        /** Bytes deallocated and waiting to be recycled. */
+        std::size_t recycled_;
+    };
+
+
+    std::vector<pool> pools_;
+    std::vector<type> types_;
+    std::vector<region> regions_;
+
+    /** Objects too large for the pools. */
+    std::size_t large_objects_ = 0;
+    std::size_t large_bytes_ = 0;
+
+    /** Bytes of the chunks holding nodes in quarantine with @c BOOST_SMART_PTR_QUARANTINE . */
+    std::size_t quarantined_bytes_ = 0;
+
+
+    /**
+        Walks every slab pool and the nodes they hold.
+    */
+
+    memory_report()
+    {
+        using namespace smart_ptr::detail;
+
+        std::map<std::type_index, type> t;
+
+        slab_pool::for_each([this, & t] (slab_pool const & p)
+        {
+            std::size_t const e = p.empty();
+
+            pools_.push_back(pool{p.chunk_size(), p.alignment(), p.slab_bytes(), p.size() / p.slab_bytes(), p.live(), p.capacity() - p.live() - e * p.chunks(), e, 0, p.nodes()});
+
+            if (! p.nodes())
+                return;
+
+            p.for_each_live([this, & p, & t] (void * c)
+            {
+#ifdef BOOST_SMART_PTR_QUARANTINE
+                // destroyed already: neither type nor size left
+                if (quarantine::poisoned(c))
+                {
+                    ++ pools_.back().quarantined_;
+                    quarantined_bytes_ += p.chunk_size();
+
+                    return;
+                }
+#endif
+
+                // node_base leads every node
+                node_base * n = static_cast<node_base *>(c);
+                char const * d = static_cast<char const *>(n->data());
+                std::size_t const b = n->size_bytes();
+                type & e = t.try_emplace(typeid(* n), type{core::demangle(typeid(* n).name()), p.chunk_size(), 0, 0, 0}).first->second;
+
+                ++ e.live_;
+                e.payload_ += b;
+
+                // the payload of containers lies elsewhere
+                if (d >= static_cast<char const *>(c) && d + b <= static_cast<char const *>(c) + p.chunk_size())
+                    e.header_ += p.chunk_size() - b;
+                else
+                    e.header_ += p.chunk_size();
+            });
+        });
+
+        for (auto & i : t)
+            types_.push_back(std::move(i.second));
+
+        large_objects_ = large_objects::instance().live_.load(std::memory_order_relaxed);
+        large_bytes_ = large_objects::instance().bytes_.load(std::memory_order_relaxed);
+    }
+
+
+    /**
+        Adds the region of a @c node_proxy .
+    */
+
+    void add(node_proxy const & x)
+    {
+        regions_.push_back(region{x.file_, x.function_, x.line_, x.region_.size(), x.region_.size() ? x.region_.tail() : 0, x.region_.recycled()});
+    }
+
+
+    /**
+        Writes a table per section.
+    */
+
+    std::ostream & text(std::ostream & out) const
+    {
+        out << "pools: chunk align slab slabs live free empty quarantined\n";
+
+        for (pool const & p : pools_)
+            out << "  " << p.chunk_size_ << ' ' << p.alignment_ << ' ' << p.slab_size_ << ' ' << p.slabs_ << ' ' << p.live_ << ' ' << p.free_ << ' ' << p.empty_ << ' ' << p.quarantined_ << (p.nodes_ ? " nodes" : "") << '\n';
+
+        out << "types: chunk live payload header name\n";
+
+        for (type const & t : types_)
+            out << "  " << t.chunk_size_ << ' ' << t.live_ << ' ' << t.payload_ << ' ' << t.header_ << ' ' << t.name_ << '\n';
+
+        out << "regions: size tail recycled site\n";
+
+        for (region const & r : regions_)
+            out << "  " << r.size_ << ' ' << r.tail_ << ' ' << r.recycled_ << ' ' << r.function_ << " in " << r.file_ << " line " << r.line_ << '\n';
+
+        out << "large: " << large_objects_ << ' ' << large_bytes_ << '\n';
+
+        return out << "quarantined: " << quarantined_bytes_ << '\n';
+    }
+
+
+    /**
+        Writes a single JSON object.
+    */
+
+    std::ostream & json(std::ostream & out) const
+    {
+        using smart_ptr::detail::quote;
+
+        char const * s = "";
+
+        out << "{\"pools\":[";
+
+        for (pool const & p : pools_)
+        {
+            out << s << "{\"chunk\":" << p.chunk_size_ << ",\"align\":" << p.alignment_ << ",\"slab\":" << p.slab_size_ << ",\"slabs\":" << p.slabs_ << ",\"live\":" << p.live_ << ",\"free\":" << p.free_ << ",\"empty\":" << p.empty_ << ",\"quarantined\":" << p.quarantined_ << ",\"nodes\":" << (p.nodes_ ? "true" : "false") << '}';
+            s = ",";
+        }
+
+        out << "],\"types\":[";
+        s = "";
+
+        for (type const & t : types_)
+        {
+            out << s << "{\"name\":";
+            quote(out, t.name_.c_str()) << ",\"chunk\":" << t.chunk_size_ << ",\"live\":" << t.live_ << ",\"payload\":" << t.payload_ << ",\"header\":" << t.header_ << '}';
+            s = ",";
+        }
+
+        out << "],\"regions\":[";
+        s = "";
+
+        for (region const & r : regions_)
+        {
+            out << s << "{\"file\":";
+            quote(out, r.file_) << ",\"function\":";
+            quote(out, r.function_) << ",\"line\":" << r.line_ << ",\"size\":" << r.size_ << ",\"tail\":" << r.tail_ << ",\"recycled\":" << r.recycled_ << '}';
+            s = ",";
+        }
+
+        return out << "],\"large\":{\"objects\":" << large_objects_ << ",\"bytes\":" << large_bytes_ << "},\"quarantined\":" << quarantined_bytes_ << "}\n";
+    }
+};
+
+
+} // namespace boost
+
+
+#endif // #ifndef BOOST_MEMORY_REPORT_INCLUDED
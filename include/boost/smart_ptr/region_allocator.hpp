@@ -0,0 +1,158 @@
+/*!
+    \file
+    \brief Boost region_allocator.hpp header file.
+
+    Patent US11288049B2
+    'SOURCE TO SOURCE COMPILER, COMPILATION METHOD, AND
+    COMPUTER-READABLE MEDIUM FOR PREDICTABLE MEMORY MANAGEMENT'
+
+    Copyright (C) 2020-2026 Fornux LLC
+
+    Phil Bouchard, Founder & CEO
+    Fornux LLC
+    phil@fornux.com
+    3909 S Maryland Pkwy Ste 314 #638, Las Vegas, NV, 89119
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef BOOST_REGION_ALLOCATOR_INCLUDED
+#define BOOST_REGION_ALLOCATOR_INCLUDED
+
+
+#include <cstddef>
+#include <type_traits>
+
+#include <boost/smart_ptr/root_ptr.hpp>
+
+
+namespace boost
+{
+
+
+/**
+    Allocator drawing from the memory of a @c node_proxy .
+
+    Lets containers held by pointee objects live next to their owner.  The memory is returned in
+    bulk when the @c node_proxy is reset, thus containers using it must not outlive that reset.
+*/
+
+template <typename T>
+    class region_allocator
+    {
+        template <typename> friend class region_allocator;
+
+    public:
+        typedef T value_type;
+        typedef T * pointer;
+        typedef T const * const_pointer;
+        typedef T & reference;
+        typedef T const & const_reference;
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+
+        typedef std::true_type propagate_on_container_copy_assignment;
+        typedef std::true_type propagate_on_container_move_assignment;
+        typedef std::true_type propagate_on_container_swap;
+
+        template <typename U>
+            struct rebind
+            {
+                typedef region_allocator<U> other;
+            };
+
+
+        region_allocator(node_proxy const & x) noexcept
+        : x_(& x)
+        {
+        }
+
+        template <typename U>
+            region_allocator(region_allocator<U> const & a) noexcept
+            : x_(a.x_)
+            {
+            }
+
+
+        T * allocate(size_type n)
+        {
+            smart_ptr::detail::quota_guard g(x_->quota_, n * sizeof(T), 0);
+            T * p = static_cast<T *>(x_->region_.allocate(n * sizeof(T), alignof(T)));
+
+            g.commit();
+
+            return p;
+        }
+
+        void deallocate(T * p, size_type n)
+        {
+            x_->region_.deallocate(p, n * sizeof(T), alignof(T));
+
+            if (x_->quota_)
+                x_->quota_->credit(n * sizeof(T), 0);
+        }
+
+
+        /**
+            Owner of the memory.
+        */
+
+        node_proxy const & proxy() const
+        {
+            return * x_;
+        }
+
+        template <typename U>
+            bool operator == (region_allocator<U> const & a) const
+            {
+                return x_ == a.x_;
+            }
+
+        template <typename U>
+            bool operator != (region_allocator<U> const & a) const
+            {
+                return x_ != a.x_;
+            }
+
+    private:
+        node_proxy const * x_;
+    };
+
+
+namespace smart_ptr
+{
+
+namespace detail
+{
+
+
+template <typename T>
+    struct is_zeroizing<region_allocator<T>> : std::true_type
+    {
+    };
+
+template <typename T>
+    struct charges_quota<region_allocator<T>> : std::true_type
+    {
+    };
+
+
+} // namespace detail
+
+} // namespace smart_ptr
+
+
+} // namespace boost
+
+
+#endif // #ifndef BOOST_REGION_ALLOCATOR_INCLUDED
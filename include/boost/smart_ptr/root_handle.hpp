@@ -0,0 +1,168 @@
+/*!
+    \file
+    \brief Boost root_handle.hpp header file.
+
+    Patent US11288049B2
+    'SOURCE TO SOURCE COMPILER, COMPILATION METHOD, AND
+    COMPUTER-READABLE MEDIUM FOR PREDICTABLE MEMORY MANAGEMENT'
+
+    Copyright (C) 2020-2026 Fornux LLC
+
+    Phil Bouchard, Founder & CEO
+    Fornux LLC
+    phil@fornux.com
+    3909 S Maryland Pkwy Ste 314 #638, Las Vegas, NV, 89119
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef BOOST_ROOT_HANDLE_INCLUDED
+#define BOOST_ROOT_HANDLE_INCLUDED
+
+
+#ifndef BOOST_SMART_PTR_HANDLES
+#error "boost/smart_ptr/root_handle.hpp requires BOOST_SMART_PTR_HANDLES to be defined in all translation units"
+#endif
+
+#include <cstdint>
+
+#include <boost/smart_ptr/root_ptr.hpp>
+#include <boost/smart_ptr/detail/slot_table.hpp>
+
+
+namespace boost
+{
+
+
+/**
+    Handle to the pointee object of a @c root_ptr , checked by generation.
+
+    Holds the index of the slot of the node and the generation of the slot when the handle was 
+    taken, in 8 bytes.  A dereference compares both generations, thus a handle outliving its node 
+    throws a @c root_error instead of reaching freed or reused memory.
+
+    A handle does not keep its node alive, across threads either: a dereference racing with the 
+    destruction of the node by another thread throws if it comes after, but the pointee object 
+    returned just before is only safe to use while a @c root_ptr to the node is held.  Generations 
+    are 32 bits wide and wrap around after as many destructions in a slot.
+*/
+
+template <typename T>
+    class root_handle
+    {
+        typedef smart_ptr::detail::slot_table slot_table;
+
+    public:
+        typedef T element_type;
+
+
+        /**
+            Null handle.
+        */
+
+        root_handle() noexcept
+        : index_(0)
+        , generation_(0)
+        {
+        }
+
+
+        /**
+            Takes a handle to the pointee object of a pointer.
+
+            @param  p   Pointer to the pointee object of a node, or null.
+        */
+
+        template <typename C>
+            explicit root_handle(root_ptr<T, C> const & p)
+            : index_(0)
+            , generation_(0)
+            {
+                if (! p.po_)
+                    return;
+
+                void * d = const_cast<void *>(p.po_->data());
+
+                // the slot designates the pointee object as a whole
+                if (BOOST_UNLIKELY(p.pi_ != d))
+                    smart_ptr::detail::throw_root_error(root_error::bad_cast);
+
+                index_ = slot_table::instance().assign(p.po_->slot_, d);
+                generation_ = slot_table::instance().generation(index_);
+            }
+
+
+        /**
+            Pointee object, or null for the null handle.
+
+            Throws a @c root_error if the node was destroyed.
+        */
+
+        T * get() const
+        {
+            void * p;
+
+            if (BOOST_UNLIKELY(! slot_table::instance().load(index_, generation_, p)))
+                smart_ptr::detail::throw_root_error(root_error::use_after_free);
+
+            return static_cast<T *>(p);
+        }
+
+        T & operator * () const
+        {
+            return * get();
+        }
+
+        T * operator -> () const
+        {
+            return get();
+        }
+
+
+        /**
+            Whether the node was destroyed since the handle was taken.
+        */
+
+        bool expired() const noexcept
+        {
+            return slot_table::instance().generation(index_) != generation_;
+        }
+
+        explicit operator bool () const noexcept
+        {
+            return index_ && ! expired();
+        }
+
+        bool operator == (root_handle const & o) const noexcept
+        {
+            return index_ == o.index_ && generation_ == o.generation_;
+        }
+
+        bool operator != (root_handle const & o) const noexcept
+        {
+            return ! (* this == o);
+        }
+
+    private:
+        /** Slot of the node. */
+        std::uint32_t index_;
+
+        /** Generation of the slot when the handle was taken. */
+        std::uint32_t generation_;
+    };
+
+
+} // namespace boost
+
+
+#endif // #ifndef BOOST_ROOT_HANDLE_INCLUDED
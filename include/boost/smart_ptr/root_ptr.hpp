@@ -40,11 +40,14 @@
 #include <cstdlib>
 
 #include <array>
+#include <memory>
 #include <vector>
 #include <atomic>
 #include <limits>
 #include <utility>
 #include <sstream>
+#include <algorithm>
+#include <memory_resource>
 #include <initializer_list>
 
 #ifndef BOOST_DISABLE_THREADS
@@ -55,9 +58,13 @@
 
 #include <iostream>
 #include <boost/log/trivial.hpp>
+#include <boost/core/no_exceptions_support.hpp>
 #include <boost/tti/has_static_member_function.hpp>
 #include <boost/smart_ptr/detail/intrusive_list.hpp>
 #include <boost/smart_ptr/detail/node_base.hpp>
+#include <boost/smart_ptr/detail/region.hpp>
+#include <boost/smart_ptr/detail/reporter.hpp>
+#include <boost/smart_ptr/detail/root_error.hpp>
 
 
 namespace boost
@@ -74,6 +81,9 @@ static inline std::recursive_mutex & static_recursive_mutex()
 {
     static std::recursive_mutex mutex_;
 
+    // only called to be locked
+    smart_ptr::detail::count(smart_ptr::detail::counter::locks);
+
     return mutex_;
 }
 #endif
@@ -108,27 +118,44 @@ struct node_proxy
     /** List of all pointer instances belonging to a @c node_proxy . */
     mutable smart_ptr::detail::intrusive_list root_set_;
 
+    /** Memory used by @c region_allocator . */
+    mutable smart_ptr::detail::region region_;
+
+    /** Memory resource of @c pmr_node . */
+    std::pmr::memory_resource * resource_;
+
+    /** Quota the memory allocated for this @c node_proxy is charged to. */
+    memory_quota * quota_;
+
+#ifdef BOOST_SMART_PTR_HEAP_PROFILE
+    /** Call site within the chain of parents, holding the live nodes allocated for it. */
+    smart_ptr::detail::heap_site * site_;
+#endif
+
 
     /**
         Initialization of a single @c node_proxy .
     */
 
-    node_proxy(char const * file, char const * function, unsigned line, node_proxy const * parent = nullptr, size_t depth = 0) : file_(file), function_(function), line_(line), parent_(parent), depth_(parent ? parent->depth_ + 1 : 0), destroying_(false)
+    node_proxy(char const * file, char const * function, unsigned line, node_proxy const * parent = nullptr, size_t = 0) : file_(file), function_(function), line_(line), parent_(parent), depth_(parent ? parent->depth_ + 1 : 0), destroying_(false), resource_(parent ? parent->resource_ : nullptr), quota_(parent ? parent->quota_ : nullptr)
     {
 #ifndef BOOST_DISABLE_THREADS
         std::scoped_lock guard(static_recursive_mutex());
 #endif
 
+#ifdef BOOST_SMART_PTR_HEAP_PROFILE
+        site_ = smart_ptr::detail::heap_site::intern(parent ? parent->site_ : nullptr, file, function, line);
+#endif
+
+        smart_ptr::detail::proxy_lifetime(this, depth_, true);
+
         * top_node_proxy() = this;
     }
 
 
     static node_proxy const ** top_node_proxy()
     {
-#ifndef BOOST_DISABLE_THREADS
-        std::scoped_lock guard(static_recursive_mutex());
-#endif
-
+        // thread local: no lock needed
         static thread_local node_proxy const * p;
 
         return & p;
@@ -177,6 +204,8 @@ struct node_proxy
 
         reset();
 
+        smart_ptr::detail::proxy_lifetime(this, depth_, false);
+
         * top_node_proxy() = parent();
     }
 
@@ -199,6 +228,83 @@ struct node_proxy
     }
 
 
+    /**
+        Memory resource used to allocate @c pmr_node for this @c node_proxy .
+
+        @return     Resource given to this @c node_proxy or inherited from its parent, or else the 
+                    default resource.
+    */
+
+    std::pmr::memory_resource * resource() const
+    {
+        return resource_ ? resource_ : std::pmr::get_default_resource();
+    }
+
+
+    /**
+        Sets the memory resource used to allocate @c pmr_node for this @c node_proxy and the children
+        created afterwards.
+
+        @param  r   Resource outliving the @c node_proxy .
+    */
+
+    void resource(std::pmr::memory_resource * r)
+    {
+        resource_ = r;
+    }
+
+
+    /**
+        Quota the memory allocated for this @c node_proxy is charged to.
+
+        @return     Quota given to this @c node_proxy or inherited from its parent, if any.
+    */
+
+    memory_quota * quota() const
+    {
+        return quota_;
+    }
+
+
+    /**
+        Charges the nodes allocated by @c make_root , @c allocate_root and @c make_nodes , and the 
+        memory used by @c region_allocator , to a quota from now on.  The quota is inherited by the
+        children created afterwards.
+
+        @param  q   Quota outliving the memory charged to it.
+    */
+
+    void quota(memory_quota * q)
+    {
+        quota_ = q;
+    }
+
+
+    /**
+        Backs the memory used by @c region_allocator with huge pages from now on.
+
+        @param  b   Whether to use huge pages.
+    */
+
+    void huge_pages(bool b)
+    {
+        region_.huge_pages(b);
+    }
+
+
+    /**
+        Limits the memory used by @c region_allocator to a budget locked in RAM up front, so that 
+        allocations never fault nor call the system.  Allocations beyond throw @c budget_exceeded .
+
+        @param  n   Budget in bytes.
+    */
+
+    void realtime(size_t n)
+    {
+        region_.realtime(n);
+    }
+
+
     /**
         Get rid or delegate a series of @c node_proxy .
     */
@@ -207,6 +313,215 @@ struct node_proxy
 };
 
 
+namespace smart_ptr
+{
+
+namespace detail
+{
+
+
+/**
+    Attaches a new node to the quota charged for it, and to the call site of @c x with 
+    @c BOOST_SMART_PTR_HEAP_PROFILE .
+
+    @param  x   Owner of the node.
+    @param  p   Node.
+    @param  q   Quota charged, if any.
+    @param  n   Bytes taken from the allocator.
+*/
+
+#ifdef BOOST_SMART_PTR_HEAP_PROFILE
+inline void attach(node_proxy const & x, node_base * p, memory_quota * q, size_t n)
+{
+    p->quota_ = q;
+    p->site_ = x.site_;
+    x.site_->add(n);
+}
+#else
+inline void attach(node_proxy const &, node_base * p, memory_quota * q, size_t)
+{
+    p->quota_ = q;
+}
+#endif
+
+
+/**
+    Allocates a new node from the memory resource of @c x and charges it to its quota.
+
+    @param  x       Owner of the node, given a memory resource.
+    @param  args    Arguments forwarded to the constructor of the pointee object, preceded by the 
+                    number of elements for arrays of unknown bound.
+    @return         Pointer of the new node.
+*/
+
+template <typename T, typename... Args>
+    inline pmr_node<T> * make_pmr_node(node_proxy const & x, Args &&... args)
+    {
+        typename pmr_node<T>::allocator_type a(x.resource_);
+        size_t const n = pmr_node<T>::footprint(args...);
+        quota_guard g(x.quota_, n);
+        pmr_node<T> * p;
+
+        if constexpr (is_unbounded_array<T>::value)
+            p = pmr_node<T>::allocate(a, std::forward<Args>(args)...);
+        else
+            p = new (a) pmr_node<T>(a, std::forward<Args>(args)...);
+
+        attach(x, p, g.commit(), n);
+
+        return p;
+    }
+
+
+/**
+    Throws a @c root_error recording the chain of @c node_proxy of the calling thread.
+
+    Out of line and cold so that each check inlines to a single branch.  Without exceptions the 
+    error goes to @c throw_exception() instead.
+*/
+
+BOOST_NORETURN BOOST_NOINLINE BOOST_SMART_PTR_COLD inline void throw_root_error(root_error::kind_type k, long long i = 0, size_t n = 0)
+{
+    root_error e(k, i, n);
+
+    for (node_proxy const * p = * node_proxy::top_node_proxy(); p && p->depth_; p = p->parent_)
+        e.push(p->file_, p->function_, p->line_);
+
+#ifndef BOOST_NO_EXCEPTIONS
+    throw e;
+#else
+    boost::throw_exception(e);
+#endif
+}
+
+
+/**
+    Records an event of the audit policy, without locking nor writing anything on the spot.
+
+    @param  k   Event.
+    @param  p   Node involved, if any.
+*/
+
+inline void report(report_kind k, node_base * p)
+{
+#ifdef BOOST_SMART_PTR_QUARANTINE
+    // a node in quarantine has neither size nor type left
+    if (p && quarantine::poisoned(p))
+        p = nullptr;
+#endif
+
+    node_proxy const * x = * node_proxy::top_node_proxy();
+
+    reporter::report(report_event{k, x ? x->line_ : 0, 0, p ? p->size_bytes() : 0, x, x ? x->file_ : nullptr, x ? x->function_ : nullptr, p ? typeid(* p).name() : nullptr});
+}
+
+
+/**
+    Whether the pointee object of a node was deleted; only tracked by the checked build, or while 
+    the node is in quarantine with @c BOOST_SMART_PTR_QUARANTINE .
+*/
+
+inline bool deleted(node_base * p)
+{
+#ifdef BOOST_SMART_PTR_QUARANTINE
+    if (quarantine::poisoned(p))
+        return true;
+#endif
+
+#ifdef BOOST_REPORT
+    return p->explicit_delete_;
+#else
+    (void) p;
+
+    return false;
+#endif
+}
+
+
+/**
+    Checks a dereference through a pointer of a policy checking nulls.
+
+    Throws if the pointer is null, or if its node is in quarantine with 
+    @c BOOST_SMART_PTR_QUARANTINE .
+
+    @param  p   Node of the pointer.
+    @param  q   Address dereferenced.
+*/
+
+inline void check_dereference(node_base * p, void const * q)
+{
+    if (BOOST_UNLIKELY(! q))
+        throw_root_error(root_error::null_pointer);
+
+#ifdef BOOST_SMART_PTR_QUARANTINE
+    if (BOOST_UNLIKELY(p && quarantine::poisoned(p)))
+        throw_root_error(root_error::use_after_free);
+#else
+    (void) p;
+#endif
+}
+
+
+/**
+    Reports a use after free through a pointer of the audit policy.
+
+    @param  p   Node of the pointer.
+*/
+
+inline void audit_use(node_base * p)
+{
+    if (p && deleted(p))
+    {
+        report(report_kind::use_after_free, p);
+    }
+}
+
+
+/**
+    Reports a use after free or an access out of the pointee object through a pointer of the audit 
+    policy.
+
+    @param  p   Node of the pointer.
+    @param  q   Address accessed.
+*/
+
+template <typename T>
+    inline void audit_access(node_base * p, T const * q)
+    {
+        if (p && deleted(p))
+        {
+            report(report_kind::use_after_free, p);
+
+            return;
+        }
+
+        if (p && (p->size() == 0 || q < static_cast<T const *>(p->data()) || q >= static_cast<T const *>(p->data()) + p->size()))
+        {
+            report(report_kind::out_of_bounds, p);
+        }
+    }
+
+
+/**
+    Reports the leak of a node whose last pointer of the audit policy goes away.
+
+    @param  p   Node of the pointer.
+*/
+
+inline void audit_release(node_base * p)
+{
+    if (p && ! deleted(p))
+    {
+        report(report_kind::memory_leak, p);
+    }
+}
+
+
+} // namespace detail
+
+} // namespace smart_ptr
+
+
 #ifdef BOOST_NO_EXCEPTIONS
 void throw_exception(std::exception const & e)
 {
@@ -225,7 +540,10 @@ struct dynamic_cast_tag {};
 /**
     Smart pointer optimized for speed and memory usage.
 
-    This class represents a basic smart pointer interface.
+    This class represents a basic smart pointer interface.  Copies only lock the global mutex to 
+    enlist themselves in the root set of their @c node_proxy , and releases to destroy a node.  As 
+    with @c shared_ptr , a given pointer must not be written by a thread while another reads it, 
+    nor copied by a thread while its @c node_proxy is being reset by another.
 */
 
 
@@ -291,19 +609,11 @@ struct root_core
     : po_(p.share())
     , pi_(p.pi_)
     {
-#ifndef BOOST_DISABLE_THREADS
-        std::scoped_lock guard(static_recursive_mutex());
-#endif
-
         root_tag_.push_back(& p.root_tag_);
     }
 
     ~root_core()
     {
-#ifndef BOOST_DISABLE_THREADS
-        std::scoped_lock guard(static_recursive_mutex());
-#endif
-
         reset(nullptr);
     }
 
@@ -318,12 +628,6 @@ struct root_core
     template <typename V, typename PoolAllocator>
         root_core & operator = (node<V, PoolAllocator> * p)
         {
-            using namespace smart_ptr::detail;
-            
-#ifndef BOOST_DISABLE_THREADS
-            std::scoped_lock guard(static_recursive_mutex());
-#endif
-
             reset(p);
             
             pi_ = p->data();
@@ -340,10 +644,6 @@ struct root_core
 
     root_core & operator = (root_core const & p)
     {
-#ifndef BOOST_DISABLE_THREADS
-        std::scoped_lock guard(static_recursive_mutex());
-#endif
-
         reset(p.share());
 
         pi_ = p.pi_;
@@ -352,6 +652,26 @@ struct root_core
 
         return * this;
     }
+
+#if defined(BOOST_HAS_RVALUE_REFS)
+    /**
+        Move assignment; takes over the reference of @c p .
+
+        @param  p Pointer to steal.
+    */
+
+    root_core & operator = (root_core && p)
+    {
+        if (this != & p)
+        {
+            reset(std::exchange(p.po_, nullptr));
+
+            pi_ = std::exchange(p.pi_, nullptr);
+        }
+
+        return * this;
+    }
+#endif
     
 
     value_type * get() const
@@ -359,28 +679,39 @@ struct root_core
         return po_;
     }
 
+    /**
+        Adds a reference to the node, without locking: the owner thread of the node only bumps a 
+        plain counter.
+    */
+
     value_type * share() const
     {
-#ifndef BOOST_DISABLE_THREADS
-        std::scoped_lock guard(static_recursive_mutex());
-#endif
-
         if (po_)
         {          
             po_->add_ref_copy();
+
+            smart_ptr::detail::copied(po_);
         }
 
         return po_;
     }
 
+    /**
+        Releases the node, only locking to destroy it, and takes over a reference to @c p .
+    */
+
     void reset(value_type * p = nullptr)
     {
-#ifndef BOOST_DISABLE_THREADS
-        std::scoped_lock guard(static_recursive_mutex());
-#endif
-
         if (po_)
         {
+#ifdef BOOST_SMART_PTR_TRACE
+            smart_ptr::detail::tracer::trace(trace_kind::reset, po_);
+#endif
+
+#ifdef BOOST_SMART_PTR_QUARANTINE
+            // a stale pointer leaves the node in quarantine alone
+            if (! smart_ptr::detail::quarantine::poisoned(po_))
+#endif
             po_->release();
         }
 
@@ -403,33 +734,78 @@ inline void node_proxy::reset()
         {
             destroying(true);
 
-            for (intrusive_list::iterator<root_core, & root_core::root_tag_> p = root_set_.begin(), q = root_set_.begin(); ! root_set_.empty() && p != root_set_.end(); p = q)
+#ifdef BOOST_SMART_PTR_TRACE
+            tracer::trace(trace_kind::reset_begin, this);
+#endif
+
+            // detach everything first: destroying a node unlinks its own pointers from the list
+            std::vector<root_core::value_type *> n;
+
+            for (intrusive_list::iterator<root_core, & root_core::root_tag_> p = root_set_.begin(); p != root_set_.end(); ++ p)
             {
-                ++ q;
-                
                 if (root_core::value_type * i = p->po_)
                 {
                     p->po_ = nullptr;
                     p->pi_ = nullptr;
 
+                    n.push_back(i);
+                }
+            }
+
+#ifdef BOOST_SMART_PTR_TRACE
+            tracer::trace(trace_kind::reset_detached, this, n.size());
+#endif
+
+            // the region wipes its chunks at once when released
+            region_.retire();
+
+            // destroy each node once, in order of appearance
+            std::vector<root_core::value_type *> s(n);
+            std::vector<bool> d(s.size());
+
+            std::sort(s.begin(), s.end());
+
+            for (root_core::value_type * i : n)
+            {
+                size_t const k = std::lower_bound(s.begin(), s.end(), i) - s.begin();
+
+                if (! d[k])
+                {
+                    d[k] = true;
+
+#ifdef BOOST_SMART_PTR_LIFETIME
+                    i->expire(lifetime_end::reset);
+#endif
+
                     i->destroy();
                 }
             }
 
+#ifdef BOOST_SMART_PTR_TRACE
+            tracer::trace(trace_kind::reset_destroyed, this, std::count(d.begin(), d.end(), true));
+#endif
+
+            // all owners are gone
+            region_.release();
+
+#ifdef BOOST_SMART_PTR_TRACE
+            tracer::trace(trace_kind::reset_released, this);
+#endif
+
             destroying(false);
         }
     }
 }
 
 
-template <typename T>
+template <typename T, typename C>
     class root_ptr;
 
 
-template <>
-    class root_ptr<std::nullptr_t> : protected root_core
+template <typename C>
+    class root_ptr<std::nullptr_t, C> : protected root_core
     {
-        template <typename> friend class root_ptr;
+        template <typename, typename> friend class root_ptr;
 
         template <typename U, typename V> friend root_ptr<U> static_pointer_cast(root_ptr<V> const & p);
         template <typename U, typename V> friend root_ptr<U> dynamic_pointer_cast(root_ptr<V> const & p);
@@ -442,6 +818,7 @@ template <>
 
     public:
         typedef typename base::value_type value_type;
+        typedef C checking_policy;
 
 
         root_ptr(node_proxy const & x, std::nullptr_t p)
@@ -470,14 +847,14 @@ template <>
                 return V(pi_);
             }
 
-        template <typename V>
-            bool operator == (root_ptr<V> const & o) const
+        template <typename V, typename D>
+            bool operator == (root_ptr<V, D> const & o) const
             {
                 return pi_ == o.pi_;
             }
 
-        template <typename V>
-            bool operator != (root_ptr<V> const & o) const
+        template <typename V, typename D>
+            bool operator != (root_ptr<V, D> const & o) const
             {
                 return pi_ != o.pi_;
             }
@@ -495,24 +872,17 @@ template <>
 
         ~root_ptr()
         {
-#ifdef BOOST_REPORT
-#ifndef BOOST_DISABLE_THREADS
-            std::scoped_lock guard(static_recursive_mutex());
-#endif
-
-            if (base::get() && base::get()->explicit_delete_ == false)
-            {
-                std::cerr << "report; memory leak; " << base::get()->size_bytes() << std::endl;
-            }
-#endif
+            if constexpr (C::audit)
+                smart_ptr::detail::audit_release(base::get());
         }
     };
 
 
-template <typename T>
+template <typename T, typename C>
     class root_ptr : protected root_core
     {
-        template <typename> friend class root_ptr;
+        template <typename, typename> friend class root_ptr;
+        template <typename> friend class root_handle;
 
         template <typename U, typename V> friend root_ptr<U> static_pointer_cast(root_ptr<V> const & p);
         template <typename U, typename V> friend root_ptr<U> dynamic_pointer_cast(root_ptr<V> const & p);
@@ -525,6 +895,7 @@ template <typename T>
 
     public:
         typedef typename base::value_type value_type;
+        typedef C checking_policy;
 
 
         root_ptr(root_ptr const & p)
@@ -532,8 +903,8 @@ template <typename T>
         {
         }
 
-        template <typename V>
-            root_ptr(root_ptr<V> const & p)
+        template <typename V, typename D>
+            root_ptr(root_ptr<V, D> const & p)
             : base(p)
             {
             }
@@ -550,8 +921,8 @@ template <typename T>
             }
 
 #if defined(BOOST_HAS_RVALUE_REFS)
-        template <typename V>
-            root_ptr(root_ptr<V> && p)
+        template <typename V, typename D>
+            root_ptr(root_ptr<V, D> && p)
             : base(std::move(p))
             {
             }
@@ -615,8 +986,8 @@ template <typename T>
             }
 
 
-        template <typename V>
-            root_ptr(node_proxy const & x, root_ptr<V> const & p)
+        template <typename V, typename D>
+            root_ptr(node_proxy const & x, root_ptr<V, D> const & p)
             : base(p)
             {
             }
@@ -628,23 +999,13 @@ template <typename T>
             @param  p New pointer to manage.
         */
 
-        template <typename V>
-            root_ptr(root_ptr<V> const & p, static_cast_tag const & t)
+        template <typename V, typename D>
+            root_ptr(root_ptr<V, D> const & p, static_cast_tag const & t)
             : base(p, static_cast<T *>(p.pi_))
             {
-#ifndef BOOST_NO_EXCEPTIONS
-#ifndef BOOST_DISABLE_THREADS
-                std::scoped_lock guard(static_recursive_mutex());
-#endif
-
-                if (! pi_)
-                {
-                    std::stringstream out;
-                    out << "internal error\n";
-                    node_proxy::stacktrace(out, * node_proxy::top_node_proxy());
-                    throw std::out_of_range(out.str());
-                }
-#endif
+                if constexpr (C::nulls)
+                    if (BOOST_UNLIKELY(! pi_))
+                        smart_ptr::detail::throw_root_error(root_error::bad_cast);
             }
 
         /**
@@ -653,31 +1014,17 @@ template <typename T>
             @param  p New pointer to manage.
         */
 
-        template <typename V>
-            root_ptr(root_ptr<V> const & p, dynamic_cast_tag const & t)
+        template <typename V, typename D>
+            root_ptr(root_ptr<V, D> const & p, dynamic_cast_tag const & t)
             : base(p, dynamic_cast<T *>(p.pi_))
             {
-#ifndef BOOST_NO_EXCEPTIONS
-#ifndef BOOST_DISABLE_THREADS
-                std::scoped_lock guard(static_recursive_mutex());
-#endif
-
-                if (! pi_)
-                {
-                    std::stringstream out;
-                    out << "internal error\n";
-                    node_proxy::stacktrace(out, * node_proxy::top_node_proxy());
-                    throw std::out_of_range(out.str());
-                }
-#endif
+                if constexpr (C::nulls)
+                    if (BOOST_UNLIKELY(! pi_))
+                        smart_ptr::detail::throw_root_error(root_error::bad_cast);
             }
 
         root_ptr & operator = (root_ptr<std::nullptr_t> const & p)
         {
-#ifndef BOOST_DISABLE_THREADS
-            std::scoped_lock guard(static_recursive_mutex());
-#endif
-
             return static_cast<root_ptr &>(base::operator = (p));
         }
 
@@ -698,127 +1045,62 @@ template <typename T>
         template <typename V, typename PoolAllocator>
             root_ptr & operator = (node<V, PoolAllocator> * p)
             {
-#ifndef BOOST_DISABLE_THREADS
-                std::scoped_lock guard(static_recursive_mutex());
-#endif
-
                 return static_cast<root_ptr &>(base::template operator = <V, PoolAllocator>(p));
             }
 
-        template <typename V>
-            root_ptr & operator = (root_ptr<V> const & p)
+        template <typename V, typename D>
+            root_ptr & operator = (root_ptr<V, D> const & p)
             {
-#ifndef BOOST_DISABLE_THREADS
-                std::scoped_lock guard(static_recursive_mutex());
-#endif
-
-                return static_cast<root_ptr &>(base::template operator = <V>(p));
+                return static_cast<root_ptr &>(base::operator = (p));
             }
 
             root_ptr & operator = (root_ptr const & p)
             {
-#ifndef BOOST_DISABLE_THREADS
-                std::scoped_lock guard(static_recursive_mutex());
-#endif
-
                 return static_cast<root_ptr &>(base::operator = (p));
             }
 
-        T & operator * () const
-        {
-#ifndef BOOST_DISABLE_THREADS
-            std::scoped_lock guard(static_recursive_mutex());
-#endif
-
-#ifdef BOOST_REPORT
-            if (base::get() && base::get()->explicit_delete_ == true)
-            {
-                std::cerr << "report; use after free; " << 1 << std::endl;
-            }
-#endif
-
-#ifdef BOOST_REPORT
-            if (base::get() && (base::get()->size() == 0 || pi_ < static_cast<T *>(const_cast<void *>(base::get()->data())) || pi_ >= static_cast<T *>(const_cast<void *>(base::get()->data())) + base::get()->size()))
+#if defined(BOOST_HAS_RVALUE_REFS)
+            root_ptr & operator = (root_ptr && p)
             {
-                std::cerr << "report; out of bounds; " << 1 << std::endl;
+                return static_cast<root_ptr &>(base::operator = (std::move(p)));
             }
 #endif
 
-#ifndef BOOST_NO_EXCEPTIONS
-            if (! pi_)
-            {
-                std::stringstream out;
-                out << "null pointer\n";
-                node_proxy::stacktrace(out, * node_proxy::top_node_proxy());
-                throw std::out_of_range(out.str());
-            }
-#endif
+        T & operator * () const
+        {
+            smart_ptr::detail::check_lock<C::locks> guard;
 
-            return * static_cast<T *>(const_cast<void *>(pi_));
-        }
+            if constexpr (C::audit)
+                smart_ptr::detail::audit_access(base::get(), static_cast<T const *>(pi_));
 
-        T * operator -> ()
-        {
-#ifndef BOOST_DISABLE_THREADS
-            std::scoped_lock guard(static_recursive_mutex());
-#endif
+            if constexpr (C::nulls)
+                smart_ptr::detail::check_dereference(base::get(), pi_);
 
-#ifdef BOOST_REPORT
-            if (base::get() && base::get()->explicit_delete_ == true)
-            {
-                std::cerr << "report; use after free; " << 1 << std::endl;
-            }
-#endif
+            return * static_cast<T *>(const_cast<void *>(pi_));
+        }
 
-#ifdef BOOST_REPORT
-            if (base::get() && (base::get()->size() == 0 || pi_ < static_cast<T *>(const_cast<void *>(base::get()->data())) || pi_ >= static_cast<T *>(const_cast<void *>(base::get()->data())) + base::get()->size()))
-            {
-                std::cerr << "report; out of bounds; " << 1 << std::endl;
-            }
-#endif
+        T * operator -> ()
+        {
+            smart_ptr::detail::check_lock<C::locks> guard;
 
-#ifndef BOOST_NO_EXCEPTIONS
-            if (! pi_)
-            {
-                std::stringstream out;
-                out << "null pointer\n";
-                node_proxy::stacktrace(out, * node_proxy::top_node_proxy());
-                throw std::out_of_range(out.str());
-            }
-#endif
+            if constexpr (C::audit)
+                smart_ptr::detail::audit_access(base::get(), static_cast<T const *>(pi_));
+
+            if constexpr (C::nulls)
+                smart_ptr::detail::check_dereference(base::get(), pi_);
 
             return static_cast<T *>(const_cast<void *>(pi_));
         }
 
         T const * operator -> () const
         {
-#ifndef BOOST_DISABLE_THREADS
-            std::scoped_lock guard(static_recursive_mutex());
-#endif
-
-#ifdef BOOST_REPORT
-            if (base::get() && base::get()->explicit_delete_ == true)
-            {
-                std::cerr << "report; use after free; " << 1 << std::endl;
-            }
-#endif
+            smart_ptr::detail::check_lock<C::locks> guard;
 
-#ifdef BOOST_REPORT
-            if (base::get() && (base::get()->size() == 0 || pi_ < static_cast<T *>(const_cast<void *>(base::get()->data())) || pi_ >= static_cast<T *>(const_cast<void *>(base::get()->data())) + base::get()->size()))
-            {
-                std::cerr << "report; out of bounds; " << 1 << std::endl;
-            }
-#endif
+            if constexpr (C::audit)
+                smart_ptr::detail::audit_access(base::get(), static_cast<T const *>(pi_));
 
-#ifndef BOOST_NO_EXCEPTIONS
-            if (! pi_)
-            {
-                std::stringstream out;
-                out << "null pointer\n";
-                node_proxy::stacktrace(out, * node_proxy::top_node_proxy());
-                throw std::out_of_range(out.str());
-            }
-#endif
+            if constexpr (C::nulls)
+                smart_ptr::detail::check_dereference(base::get(), pi_);
 
             return static_cast<T const *>(pi_);
         }
@@ -831,16 +1113,8 @@ template <typename T>
 #if 1
         operator T * ()
         {
-#ifdef BOOST_REPORT
-#ifndef BOOST_DISABLE_THREADS
-            std::scoped_lock guard(static_recursive_mutex());
-#endif
-
-            if (base::get() && base::get()->explicit_delete_ == true)
-            {
-                std::cerr << "report; use after free; " << 1 << std::endl;
-            }
-#endif
+            if constexpr (C::audit)
+                smart_ptr::detail::audit_use(base::get());
 
             return static_cast<T *>(const_cast<void *>(pi_));
         }
@@ -848,16 +1122,8 @@ template <typename T>
 #if 1
         operator T const * () const
         {
-#ifdef BOOST_REPORT
-#ifndef BOOST_DISABLE_THREADS
-            std::scoped_lock guard(static_recursive_mutex());
-#endif
-
-            if (base::get() && base::get()->explicit_delete_ == true)
-            {
-                std::cerr << "report; use after free; " << 1 << std::endl;
-            }
-#endif
+            if constexpr (C::audit)
+                smart_ptr::detail::audit_use(base::get());
 
             return static_cast<T const *>(pi_);
         }
@@ -866,56 +1132,46 @@ template <typename T>
 
         root_ptr & operator ++ ()
         {
-#ifndef BOOST_DISABLE_THREADS
-            std::scoped_lock guard(static_recursive_mutex());
-#endif
+            smart_ptr::detail::check_lock<C::locks> guard;
 
-            return ++ static_cast<T * &>(pi_), * this;
+            return pi_ = static_cast<T const *>(pi_) + 1, * this;
         }
 
         root_ptr & operator -- ()
         {
-#ifndef BOOST_DISABLE_THREADS
-            std::scoped_lock guard(static_recursive_mutex());
-#endif
+            smart_ptr::detail::check_lock<C::locks> guard;
 
-            return -- static_cast<T * &>(pi_), * this;
+            return pi_ = static_cast<T const *>(pi_) - 1, * this;
         }
 
         root_ptr operator ++ (int)
         {
-#ifndef BOOST_DISABLE_THREADS
-            std::scoped_lock guard(static_recursive_mutex());
-#endif
+            smart_ptr::detail::check_lock<C::locks> guard;
 
             root_ptr temp(* this);
 
-            return ++ static_cast<T * &>(pi_), temp;
+            return pi_ = static_cast<T const *>(pi_) + 1, temp;
         }
 
         root_ptr operator -- (int)
         {
-#ifndef BOOST_DISABLE_THREADS
-            std::scoped_lock guard(static_recursive_mutex());
-#endif
+            smart_ptr::detail::check_lock<C::locks> guard;
 
             root_ptr temp(* this);
 
-            return -- static_cast<T * &>(pi_), temp;
+            return pi_ = static_cast<T const *>(pi_) - 1, temp;
         }
 
         ptrdiff_t operator - (root_ptr const & o) const
         {
-            return static_cast<T * &>(pi_) - static_cast<T * &>(o.pi_);
+            return static_cast<T const *>(pi_) - static_cast<T const *>(o.pi_);
         }
 
 #if 1
         template <typename V>
             root_ptr operator + (V i) const
             {
-#ifndef BOOST_DISABLE_THREADS
-                std::scoped_lock guard(static_recursive_mutex());
-#endif
+                smart_ptr::detail::check_lock<C::locks> guard;
 
                 root_ptr res(* this);
                 
@@ -927,9 +1183,7 @@ template <typename T>
         template <typename V>
             root_ptr operator - (V i) const
             {
-#ifndef BOOST_DISABLE_THREADS
-                std::scoped_lock guard(static_recursive_mutex());
-#endif
+                smart_ptr::detail::check_lock<C::locks> guard;
 
                 root_ptr res(* this);
                 
@@ -942,19 +1196,11 @@ template <typename T>
         template <typename V>
             root_ptr & operator += (V i)
             {
-#ifndef BOOST_DISABLE_THREADS
-                std::scoped_lock guard(static_recursive_mutex());
-#endif
+                smart_ptr::detail::check_lock<C::locks> guard;
 
-#ifndef BOOST_NO_EXCEPTIONS
-                if (! pi_)
-                {
-                    std::stringstream out;
-                    out << "null pointer\n";
-                    node_proxy::stacktrace(out, * node_proxy::top_node_proxy());
-                    throw std::out_of_range(out.str());
-                }
-#endif
+                if constexpr (C::nulls)
+                    if (BOOST_UNLIKELY(! pi_))
+                        smart_ptr::detail::throw_root_error(root_error::null_pointer);
 
                 pi_ = static_cast<T const *>(pi_) + i;
                 
@@ -964,33 +1210,25 @@ template <typename T>
         template <typename V>
             root_ptr & operator -= (V i)
             {
-#ifndef BOOST_DISABLE_THREADS
-                std::scoped_lock guard(static_recursive_mutex());
-#endif
+                smart_ptr::detail::check_lock<C::locks> guard;
 
-#ifndef BOOST_NO_EXCEPTIONS
-                if (! pi_)
-                {
-                    std::stringstream out;
-                    out << "null pointer\n";
-                    node_proxy::stacktrace(out, * node_proxy::top_node_proxy());
-                    throw std::out_of_range(out.str());
-                }
-#endif
+                if constexpr (C::nulls)
+                    if (BOOST_UNLIKELY(! pi_))
+                        smart_ptr::detail::throw_root_error(root_error::null_pointer);
 
                 pi_ = static_cast<T const *>(pi_) - i;
 
                 return * this;
             }
 
-        template <typename V>
-            bool operator == (root_ptr<V> const & o) const
+        template <typename V, typename D>
+            bool operator == (root_ptr<V, D> const & o) const
             {
                 return pi_ == o.pi_;
             }
 
-        template <typename V>
-            bool operator != (root_ptr<V> const & o) const
+        template <typename V, typename D>
+            bool operator != (root_ptr<V, D> const & o) const
             {
                 return pi_ != o.pi_;
             }
@@ -1005,65 +1243,57 @@ template <typename T>
                 return pi_ != nullptr;
             }
 
-        template <typename V>
-            bool operator < (root_ptr<V> const & o) const
+        template <typename V, typename D>
+            bool operator < (root_ptr<V, D> const & o) const
             {
                 return pi_ < o.pi_;
             }
 
-        template <typename V>
-            bool operator > (root_ptr<V> const & o) const
+        template <typename V, typename D>
+            bool operator > (root_ptr<V, D> const & o) const
             {
                 return pi_ > o.pi_;
             }
 
-        template <typename V>
-            bool operator <= (root_ptr<V> const & o) const
+        template <typename V, typename D>
+            bool operator <= (root_ptr<V, D> const & o) const
             {
                 return pi_ <= o.pi_;
             }
 
-        template <typename V>
-            bool operator >= (root_ptr<V> const & o) const
+        template <typename V, typename D>
+            bool operator >= (root_ptr<V, D> const & o) const
             {
                 return pi_ >= o.pi_;
             }
 
         ~root_ptr()
         {
-#ifdef BOOST_REPORT
-#ifndef BOOST_DISABLE_THREADS
-            std::scoped_lock guard(static_recursive_mutex());
-#endif
-
-            if (base::get() && base::get()->explicit_delete_ == false)
-            {
-                std::cerr << "report; memory leak; " << base::get()->size_bytes() << std::endl;
-            }
-#endif
+            if constexpr (C::audit)
+                smart_ptr::detail::audit_release(base::get());
         }
     };
     
     
 #if 1
-template <typename T>
-    class root_ptr<const T> : public root_ptr<T>
+template <typename T, typename C>
+    class root_ptr<const T, C> : public root_ptr<T, C>
     {
     public:
-        using root_ptr<T>::root_ptr;
+        using root_ptr<T, C>::root_ptr;
         
-        root_ptr(root_ptr<T> const & p)
-        : root_ptr<T>(p)
+        root_ptr(root_ptr<T, C> const & p)
+        : root_ptr<T, C>(p)
         {
         }
     };
 #endif
 
 
-template <>
-    class root_ptr<void> : protected root_core
+template <typename C>
+    class root_ptr<void, C> : protected root_core
     {
-        template <typename> friend class root_ptr;
+        template <typename, typename> friend class root_ptr;
 
         template <typename U, typename V> friend root_ptr<U> static_pointer_cast(root_ptr<V> const & p);
         template <typename U, typename V> friend root_ptr<U> dynamic_pointer_cast(root_ptr<V> const & p);
@@ -1076,6 +1306,7 @@ template <>
 
     public:
         typedef typename base::value_type value_type;
+        typedef C checking_policy;
 
 
         root_ptr(root_ptr const & p)
@@ -1083,8 +1314,8 @@ template <>
         {
         }
 
-        template <typename V>
-            root_ptr(root_ptr<V> const & p)
+        template <typename V, typename D>
+            root_ptr(root_ptr<V, D> const & p)
             : base(p)
             {
             }
@@ -1095,8 +1326,8 @@ template <>
             }
 
 #if defined(BOOST_HAS_RVALUE_REFS)
-        template <typename V>
-            root_ptr(root_ptr<V> && p)
+        template <typename V, typename D>
+            root_ptr(root_ptr<V, D> && p)
             : base(std::move(p))
             {
             }
@@ -1129,8 +1360,8 @@ template <>
             {
             }
             
-        template <typename V>
-            root_ptr(node_proxy const & x, root_ptr<V> const & p)
+        template <typename V, typename D>
+            root_ptr(node_proxy const & x, root_ptr<V, D> const & p)
             : base(p)
             {
             }
@@ -1141,8 +1372,8 @@ template <>
             @param  p New pointer to manage.
         */
 
-        template <typename V>
-            root_ptr(root_ptr<V> const & p, static_cast_tag const & t)
+        template <typename V, typename D>
+            root_ptr(root_ptr<V, D> const & p, static_cast_tag const & t)
             : base(p, static_cast<void *>(p.pi_))
             {
             }
@@ -1154,8 +1385,8 @@ template <>
             @param  p New pointer to manage.
         */
 
-        template <typename V>
-            root_ptr(root_ptr<V> const & p, dynamic_cast_tag const & t)
+        template <typename V, typename D>
+            root_ptr(root_ptr<V, D> const & p, dynamic_cast_tag const & t)
             : base(p, dynamic_cast<void *>(p.pi_))
             {
             }
@@ -1163,29 +1394,17 @@ template <>
 
         root_ptr & operator = (root_ptr<std::nullptr_t> const & p)
         {
-#ifndef BOOST_DISABLE_THREADS
-            std::scoped_lock guard(static_recursive_mutex());
-#endif
-
             return static_cast<root_ptr &>(base::operator = (p));
         }
 
         template <typename V, typename PoolAllocator>
             root_ptr & operator = (node<V, PoolAllocator> * p)
             {
-#ifndef BOOST_DISABLE_THREADS
-                std::scoped_lock guard(static_recursive_mutex());
-#endif
-
                 return static_cast<root_ptr &>(base::template operator = <V, PoolAllocator>(p));
             }
 
             root_ptr & operator = (root_ptr const & p)
             {
-#ifndef BOOST_DISABLE_THREADS
-                std::scoped_lock guard(static_recursive_mutex());
-#endif
-
                 return static_cast<root_ptr &>(base::operator = (p));
             }
 
@@ -1206,28 +1425,20 @@ template <>
 
         operator uintptr_t () const
         {
-#ifdef BOOST_REPORT
-#ifndef BOOST_DISABLE_THREADS
-            std::scoped_lock guard(static_recursive_mutex());
-#endif
-
-            if (base::get() && base::get()->explicit_delete_ == true)
-            {
-                std::cerr << "report; use after free; " << 1 << std::endl;
-            }
-#endif
+            if constexpr (C::audit)
+                smart_ptr::detail::audit_use(base::get());
 
             return reinterpret_cast<uintptr_t>(pi_);
         }
 
-        template <typename V>
-            bool operator == (root_ptr<V> const & o) const
+        template <typename V, typename D>
+            bool operator == (root_ptr<V, D> const & o) const
             {
                 return pi_ == o.pi_;
             }
 
-        template <typename V>
-            bool operator != (root_ptr<V> const & o) const
+        template <typename V, typename D>
+            bool operator != (root_ptr<V, D> const & o) const
             {
                 return pi_ != o.pi_;
             }
@@ -1242,71 +1453,143 @@ template <>
                 return pi_ != nullptr;
             }
 
-        template <typename V>
-            bool operator < (root_ptr<V> const & o) const
+        template <typename V, typename D>
+            bool operator < (root_ptr<V, D> const & o) const
             {
                 return pi_ < o.pi_;
             }
 
-        template <typename V>
-            bool operator > (root_ptr<V> const & o) const
+        template <typename V, typename D>
+            bool operator > (root_ptr<V, D> const & o) const
             {
                 return pi_ > o.pi_;
             }
 
-        template <typename V>
-            bool operator <= (root_ptr<V> const & o) const
+        template <typename V, typename D>
+            bool operator <= (root_ptr<V, D> const & o) const
             {
                 return pi_ <= o.pi_;
             }
 
-        template <typename V>
-            bool operator >= (root_ptr<V> const & o) const
+        template <typename V, typename D>
+            bool operator >= (root_ptr<V, D> const & o) const
             {
                 return pi_ >= o.pi_;
             }
 
         ~root_ptr()
         {
-#ifdef BOOST_REPORT
-#ifndef BOOST_DISABLE_THREADS
-            std::scoped_lock guard(static_recursive_mutex());
-#endif
-
-            if (base::get() && base::get()->explicit_delete_ == false)
-            {
-                std::cerr << "report; memory leak; " << base::get()->size_bytes() << std::endl;
-            }
-#endif
+            if constexpr (C::audit)
+                smart_ptr::detail::audit_release(base::get());
         }
     };
 
 
 #if 1
-template <>
-    class root_ptr<const void> : public root_ptr<void>
+template <typename C>
+    class root_ptr<const void, C> : public root_ptr<void, C>
     {
     public:
-        using root_ptr<void>::root_ptr;
+        using root_ptr<void, C>::root_ptr;
         
-        root_ptr(root_ptr<void> const & p)
-        : root_ptr<void>(p)
+        root_ptr(root_ptr<void, C> const & p)
+        : root_ptr<void, C>(p)
         {
         }
     };
 #endif
 
 
+/**
+    Pointer to an array of runtime size.
+
+    Indexing is checked against the elements of the @c node<T[]> which follow the pointer.
+*/
+
+template <typename T, typename C>
+    class root_ptr<T[], C> : public root_ptr<T, C>
+    {
+    protected:
+        typedef root_ptr<T, C> base;
+
+        using base::po_;
+        using base::pi_;
+
+    public:
+        using root_ptr<T, C>::root_ptr;
+
+
+        /**
+            Number of elements from the pointer to the end of the array.
+        */
+
+        size_t size() const
+        {
+#ifndef BOOST_DISABLE_THREADS
+            std::scoped_lock guard(static_recursive_mutex());
+#endif
+
+            if (! po_)
+                return 0;
+
+#ifdef BOOST_SMART_PTR_QUARANTINE
+            if (smart_ptr::detail::quarantine::poisoned(po_))
+                return 0;
+#endif
+
+            ptrdiff_t const i = static_cast<T const *>(pi_) - static_cast<T const *>(po_->data());
+
+            return i < 0 || size_t(i) > po_->size() ? 0 : po_->size() - i;
+        }
+
+        template <typename V>
+            T & operator [] (V const n)
+            {
+                return const_cast<T &>(static_cast<root_ptr const &>(* this)[n]);
+            }
+
+        template <typename V>
+            T const & operator [] (V const n) const
+            {
+                smart_ptr::detail::check_lock<C::locks> guard;
+
+                if constexpr (C::audit || C::bounds)
+                {
+#ifdef BOOST_SMART_PTR_QUARANTINE
+                    // the size is out of reach of stale pointers
+                    if constexpr (C::bounds)
+                        if (BOOST_UNLIKELY(po_ && smart_ptr::detail::quarantine::poisoned(po_)))
+                            smart_ptr::detail::throw_root_error(root_error::use_after_free);
+#endif
+
+                    size_t const s = size();
+
+                    if constexpr (C::audit)
+                        if (n < 0 || s <= size_t(n))
+                        {
+                            smart_ptr::detail::report(smart_ptr::detail::report_kind::out_of_bounds, base::get());
+                        }
+
+                    if constexpr (C::bounds)
+                        if (BOOST_UNLIKELY(n < 0 || s <= size_t(n)))
+                            smart_ptr::detail::throw_root_error(root_error::out_of_bounds, n, s);
+                }
+
+                return * (static_cast<T const *>(pi_) + n);
+            }
+    };
+
+
 /**
     Allocate new buffers;
 */
 
 
-template <typename T, size_t S>
-    class root_array : public boost::root_ptr<T>
+template <typename T, size_t S, typename C>
+    class root_array : public boost::root_ptr<T, C>
     {
     protected:
-        typedef boost::root_ptr<T> base;
+        typedef boost::root_ptr<T, C> base;
 
         using base::pi_;
 
@@ -1338,26 +1621,17 @@ template <typename T, size_t S>
         template <typename V>
             T & operator [] (V const n)
             {
-#ifndef BOOST_DISABLE_THREADS
-                std::scoped_lock guard(static_recursive_mutex());
-#endif
+                smart_ptr::detail::check_lock<C::locks> guard;
 
-#ifdef BOOST_REPORT
-                if (S <= n)
-                {
-                    std::cerr << "report; out of bounds; " << 1 << std::endl;
-                }
-#endif
+                if constexpr (C::audit)
+                    if (S <= n)
+                    {
+                        smart_ptr::detail::report(smart_ptr::detail::report_kind::out_of_bounds, base::get());
+                    }
 
-#ifndef BOOST_NO_EXCEPTIONS
-                if (S <= n)
-                {
-                    std::stringstream out;
-                    out << "out of range [0, " << S << "[\n";
-                    node_proxy::stacktrace(out, * node_proxy::top_node_proxy());
-                    throw std::out_of_range(out.str());
-                }
-#endif
+                if constexpr (C::bounds)
+                    if (BOOST_UNLIKELY(S <= n))
+                        smart_ptr::detail::throw_root_error(root_error::out_of_bounds, n, S);
 
                 return * (static_cast<T *>(const_cast<void *>(pi_)) + n);
             }
@@ -1365,26 +1639,17 @@ template <typename T, size_t S>
         template <typename V>
             T const & operator [] (V const n) const
             {
-#ifndef BOOST_DISABLE_THREADS
-                std::scoped_lock guard(static_recursive_mutex());
-#endif
+                smart_ptr::detail::check_lock<C::locks> guard;
 
-#ifdef BOOST_REPORT
-                if (S <= n)
-                {
-                    std::cerr << "report; out of bounds; " << 1 << std::endl;
-                }
-#endif
+                if constexpr (C::audit)
+                    if (S <= n)
+                    {
+                        smart_ptr::detail::report(smart_ptr::detail::report_kind::out_of_bounds, base::get());
+                    }
 
-#ifndef BOOST_NO_EXCEPTIONS
-                if (S <= n)
-                {
-                    std::stringstream out;
-                    out << "out of range [0, " << S << "[\n";
-                    node_proxy::stacktrace(out, * node_proxy::top_node_proxy());
-                    throw std::out_of_range(out.str());
-                }
-#endif
+                if constexpr (C::bounds)
+                    if (BOOST_UNLIKELY(S <= n))
+                        smart_ptr::detail::throw_root_error(root_error::out_of_bounds, n, S);
 
                 return * (static_cast<T const *>(pi_) + n);
             }
@@ -1400,8 +1665,8 @@ template <typename T>
         static size_t const value = sizeof(T);
     };
 
-template <typename T, size_t S>
-    struct size_of_t<root_array<T, S>>
+template <typename T, size_t S, typename C>
+    struct size_of_t<root_array<T, S, C>>
     {
         static size_t const value = sizeof(T) * S;
     };
@@ -1412,13 +1677,132 @@ template <typename T>
         return sizeof(T);
     }
 
-template <typename T, size_t S>
-    inline size_t constexpr size_of(root_array<T, S> const &)
+template <typename T, size_t S, typename C>
+    inline size_t constexpr size_of(root_array<T, S, C> const &)
     {
         return sizeof(T) * S;
     }
 
 
+/**
+    Allocates a new pointee object and its @c root_ptr .
+
+    A single allocation constructs the pointee object in place.  Uses the memory resource of the 
+    @c node_proxy if one was given, or else the static pool of the @c node .
+
+    @param  x       Owner of the new pointer.
+    @param  args    Arguments forwarded to the constructor of the pointee object.
+*/
+
+template <typename T, typename... Args>
+    inline root_ptr<T> make_root(node_proxy const & x, Args &&... args)
+    {
+        using namespace smart_ptr::detail;
+
+        if (x.resource_)
+            return root_ptr<T>(x, make_pmr_node<T>(x, std::forward<Args>(args)...));
+
+        size_t const n = node<T>::footprint(args...);
+        quota_guard g(x.quota_, n);
+        node<T> * p = make_node<T>(std::forward<Args>(args)...);
+
+        attach(x, p, g.commit(), n);
+
+        return root_ptr<T>(x, p);
+    }
+
+
+/**
+    Allocates a new pointee object and its @c root_ptr using a copy of the allocator given.
+
+    @param  x       Owner of the new pointer.
+    @param  a       Allocator.
+    @param  args    Arguments forwarded to the constructor of the pointee object.
+*/
+
+template <typename T, typename Allocator, typename... Args>
+    inline root_ptr<T> allocate_root(node_proxy const & x, Allocator const & a, Args &&... args)
+    {
+        typedef node<T, typename std::allocator_traits<Allocator>::template rebind_alloc<T>> node_type;
+
+        using namespace smart_ptr::detail;
+
+        // region_allocator charges the bytes itself
+        size_t const n = node_type::footprint(args...);
+        quota_guard g(x.quota_, charges_quota<typename node_type::allocator_type>::value ? 0 : n);
+        node_type * p = allocate_node<T>(a, std::forward<Args>(args)...);
+
+        attach(x, p, g.commit(), n);
+
+        return root_ptr<T>(x, p);
+    }
+
+
+/**
+    Allocates a series of pointee objects and their @c root_ptr .
+
+    Storage of all @c node is taken from the static pool in a single critical section and each 
+    pointee object is then constructed in place with the same arguments.  Nodes are allocated one 
+    by one from the memory resource of the @c node_proxy instead if one was given.
+
+    @param  x       Owner of the new pointers.
+    @param  n       Number of pointee objects.
+    @param  args    Arguments given to the constructor of each pointee object.
+*/
+
+template <typename T, typename... Args>
+    inline std::vector<root_ptr<T>> make_nodes(node_proxy const & x, size_t n, Args const &... args)
+    {
+        typedef node<T> node_type;
+
+        std::vector<root_ptr<T>> r;
+
+        r.reserve(n);
+
+        if (x.resource_)
+        {
+            for (size_t i = 0; i < n; ++ i)
+                r.emplace_back(x, smart_ptr::detail::make_pmr_node<T>(x, args...));
+
+            return r;
+        }
+
+        std::unique_ptr<node_type * []> p(new node_type * [n]);
+
+        // charged at once, then credited back node by node
+        smart_ptr::detail::quota_guard g(x.quota_, n * sizeof(node_type), n);
+
+        node_type::allocate(p.get(), n);
+
+        memory_quota * const q = g.commit();
+        size_t i = 0;
+
+        BOOST_TRY
+        {
+            for (; i < n; ++ i)
+            {
+                node_type * e = ::new (static_cast<void *>(p[i])) node_type(args...);
+
+                smart_ptr::detail::attach(x, e, q, sizeof(node_type));
+                r.emplace_back(x, e);
+            }
+        }
+        BOOST_CATCH (...)
+        {
+            if (q)
+                q->credit((n - i) * sizeof(node_type), n - i);
+
+            for (; i < n; ++ i)
+                node_type::deallocate(p[i]);
+
+            BOOST_RETHROW
+        }
+        BOOST_CATCH_END
+
+        return r;
+    }
+
+
 /**
     Static cast.
 */
@@ -1514,19 +1898,19 @@ template <typename T>
 namespace std
 {
 
-template <typename T>
-    struct hash<boost::root_ptr<T>>
+template <typename T, typename C>
+    struct hash<boost::root_ptr<T, C>>
     {
-        size_t operator() (boost::root_ptr<T> const & p) const
+        size_t operator() (boost::root_ptr<T, C> const & p) const
         {
             return p.get();
         }
     };
 
-template <typename T>
-    struct equal_to<boost::root_ptr<T>>
+template <typename T, typename C>
+    struct equal_to<boost::root_ptr<T, C>>
     {
-        bool operator() (boost::root_ptr<T> const & lhs, boost::root_ptr<T> const & rhs) const
+        bool operator() (boost::root_ptr<T, C> const & lhs, boost::root_ptr<T, C> const & rhs) const
         {
             return lhs.get() == rhs.get();
         }
@@ -0,0 +1,252 @@
+/*!
+    \file
+    \brief Boost root_stats.hpp header file.
+
+    Patent US11288049B2
+    'SOURCE TO SOURCE COMPILER, COMPILATION METHOD, AND
+    COMPUTER-READABLE MEDIUM FOR PREDICTABLE MEMORY MANAGEMENT'
+
+    Copyright (C) 2020-2026 Fornux LLC
+
+    Phil Bouchard, Founder & CEO
+    Fornux LLC
+    phil@fornux.com
+    3909 S Maryland Pkwy Ste 314 #638, Las Vegas, NV, 89119
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef BOOST_ROOT_STATS_INCLUDED
+#define BOOST_ROOT_STATS_INCLUDED
+
+
+#include <string>
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <fstream>
+#include <ostream>
+#include <utility>
+
+#ifndef BOOST_DISABLE_THREADS
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#endif
+
+#include <boost/smart_ptr/root_ptr.hpp>
+#include <boost/smart_ptr/detail/counters.hpp>
+
+
+namespace boost
+{
+
+
+/**
+    Snapshot of the counters of the memory manager, summed over all threads since the start of the
+    process.
+
+    Threads are summed one after the other, thus the live counts are clamped at zero for a 
+    deallocation can be seen before its allocation.
+*/
+
+struct root_statistics
+{
+    std::uint64_t allocations_;
+    std::uint64_t frees_;
+    std::uint64_t allocated_bytes_;
+    std::uint64_t freed_bytes_;
+    std::uint64_t proxies_created_;
+    std::uint64_t proxies_destroyed_;
+
+    /** References copied. */
+    std::uint64_t copies_;
+
+    /** Acquisitions of the global mutex, recursive ones included. */
+    std::uint64_t locks_;
+
+
+    std::uint64_t live_nodes() const
+    {
+        return allocations_ > frees_ ? allocations_ - frees_ : 0;
+    }
+
+    std::uint64_t live_bytes() const
+    {
+        return allocated_bytes_ > freed_bytes_ ? allocated_bytes_ - freed_bytes_ : 0;
+    }
+
+    std::uint64_t live_proxies() const
+    {
+        return proxies_created_ > proxies_destroyed_ ? proxies_created_ - proxies_destroyed_ : 0;
+    }
+};
+
+
+/**
+    Takes a snapshot of the counters.
+*/
+
+inline root_statistics root_stats()
+{
+    using namespace smart_ptr::detail;
+
+    std::uint64_t v[counters];
+
+    counter_registry::instance().sum(v);
+
+    return root_statistics
+    {
+        v[std::size_t(counter::allocations)],
+        v[std::size_t(counter::frees)],
+        v[std::size_t(counter::allocated_bytes)],
+        v[std::size_t(counter::freed_bytes)],
+        v[std::size_t(counter::proxies_created)],
+        v[std::size_t(counter::proxies_destroyed)],
+        v[std::size_t(counter::copies)],
+        v[std::size_t(counter::locks)]
+    };
+}
+
+
+/**
+    Writes a snapshot in the OpenMetrics text format.
+
+    @param  out     Stream written.
+    @param  s       Snapshot.
+*/
+
+inline std::ostream & write_openmetrics(std::ostream & out, root_statistics const & s)
+{
+    auto const metric = [& out] (char const * name, char const * type, char const * help, std::uint64_t v)
+    {
+        bool const c = type[0] == 'c';
+
+        out << "# TYPE root_ptr_" << name << ' ' << type << '\n';
+        out << "# HELP root_ptr_" << name << ' ' << help << '\n';
+        out << "root_ptr_" << name << (c ? "_total " : " ") << v << '\n';
+    };
+
+    metric("allocations", "counter", "Nodes allocated.", s.allocations_);
+    metric("frees", "counter", "Nodes deallocated.", s.frees_);
+    metric("allocated_bytes", "counter", "Bytes of the nodes allocated.", s.allocated_bytes_);
+    metric("freed_bytes", "counter", "Bytes of the nodes deallocated.", s.freed_bytes_);
+    metric("pointer_copies", "counter", "References to a node copied.", s.copies_);
+    metric("lock_acquisitions", "counter", "Acquisitions of the global mutex.", s.locks_);
+    metric("live_nodes", "gauge", "Nodes allocated and not deallocated yet.", s.live_nodes());
+    metric("live_bytes", "gauge", "Bytes of the live nodes.", s.live_bytes());
+    metric("live_proxies", "gauge", "Instances of node_proxy alive.", s.live_proxies());
+
+    return out << "# EOF\n";
+}
+
+
+/**
+    Writes a snapshot to a file periodically for a metrics collector, such as the textfile 
+    collector of the Prometheus node exporter, from a background thread.
+
+    Each snapshot is written to a temporary file renamed over the previous one, thus the file is 
+    never seen partially written.
+*/
+
+class root_stats_writer
+{
+public:
+    /**
+        Writes a first snapshot and starts the background thread.
+
+        @param  path    File replaced at each period.
+        @param  period  Delay between two snapshots.
+    */
+
+    explicit root_stats_writer(std::string path, std::chrono::milliseconds period = std::chrono::seconds(15))
+    : path_(std::move(path))
+#ifndef BOOST_DISABLE_THREADS
+    , period_(period)
+#endif
+    {
+        write();
+
+#ifndef BOOST_DISABLE_THREADS
+        thread_ = std::thread([this]
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+
+            while (! condition_.wait_for(lock, period_, [this] { return stop_; }))
+                write();
+        });
+#endif
+    }
+
+    root_stats_writer(root_stats_writer const &) = delete;
+
+    /**
+        Stops the background thread after writing a last snapshot.
+    */
+
+    ~root_stats_writer()
+    {
+#ifndef BOOST_DISABLE_THREADS
+        {
+            std::scoped_lock guard(mutex_);
+
+            stop_ = true;
+        }
+
+        condition_.notify_one();
+        thread_.join();
+#endif
+
+        write();
+    }
+
+
+    /**
+        Writes a snapshot now.
+
+        @return     Whether the file could be written.
+    */
+
+    bool write() const
+    {
+        std::string const t = path_ + ".tmp";
+
+        {
+            std::ofstream out(t, std::ios::trunc);
+
+            if (! write_openmetrics(out, root_stats()) || ! out.flush())
+                return false;
+        }
+
+        return std::rename(t.c_str(), path_.c_str()) == 0;
+    }
+
+private:
+    std::string const path_;
+
+#ifndef BOOST_DISABLE_THREADS
+    std::chrono::milliseconds const period_;
+
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    bool stop_ = false;
+
+    std::thread thread_;
+#endif
+};
+
+
+} // namespace boost
+
+
+#endif // #ifndef BOOST_ROOT_STATS_INCLUDED
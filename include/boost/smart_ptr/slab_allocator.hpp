@@ -0,0 +1,235 @@
+/*!
+    \file
+    \brief Boost slab_allocator.hpp header file.
+
+    Patent US11288049B2
+    'SOURCE TO SOURCE COMPILER, COMPILATION METHOD, AND
+    COMPUTER-READABLE MEDIUM FOR PREDICTABLE MEMORY MANAGEMENT'
+
+    Copyright (C) 2020-2026 Fornux LLC
+
+    Phil Bouchard, Founder & CEO
+    Fornux LLC
+    phil@fornux.com
+    3909 S Maryland Pkwy Ste 314 #638, Las Vegas, NV, 89119
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef BOOST_SLAB_ALLOCATOR_INCLUDED
+#define BOOST_SLAB_ALLOCATOR_INCLUDED
+
+
+#include <cstddef>
+#include <type_traits>
+
+#ifndef BOOST_DISABLE_THREADS
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <condition_variable>
+#endif
+
+#include <boost/smart_ptr/detail/slab_pool.hpp>
+
+
+namespace boost
+{
+
+
+struct node_base;
+
+
+/**
+    Allocator drawing single objects from the slab pool of their size and alignment.
+
+    Pools are shared by all types of the same size and alignment.  Arrays are not pooled.  Objects 
+    and arrays of @c large_object bytes or more are mapped on their own and unmapped as soon as they 
+    are deallocated, so that they never bloat the pools nor stay in the process.
+*/
+
+template <typename T>
+    class slab_allocator
+    {
+    public:
+        typedef T value_type;
+        typedef T * pointer;
+        typedef T const * const_pointer;
+        typedef T & reference;
+        typedef T const & const_reference;
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+
+        enum
+        {
+            /** Size from which objects are mapped on their own. */
+            large_object = smart_ptr::detail::slab_pool::large_object
+        };
+
+        template <typename U>
+            struct rebind
+            {
+                typedef slab_allocator<U> other;
+            };
+
+
+        constexpr slab_allocator() noexcept
+        {
+        }
+
+        template <typename U>
+            constexpr slab_allocator(slab_allocator<U> const &) noexcept
+            {
+            }
+
+
+        T * allocate(size_type n)
+        {
+            if constexpr (sizeof(T) < large_object)
+                if (n == 1)
+                    return static_cast<T *>(pool().allocate());
+
+            if (n * sizeof(T) >= large_object)
+            {
+                T * p = static_cast<T *>(smart_ptr::detail::map_pages(n * sizeof(T), alignof(T)));
+
+                smart_ptr::detail::large_objects::instance().add(n * sizeof(T));
+
+                return p;
+            }
+
+            return static_cast<T *>(::operator new(n * sizeof(T), std::align_val_t(alignof(T))));
+        }
+
+        void deallocate(T * p, size_type n)
+        {
+            if constexpr (sizeof(T) < large_object)
+                if (n == 1)
+                    return pool().deallocate(p);
+
+            if (n * sizeof(T) >= large_object)
+            {
+                smart_ptr::detail::unmap_pages(p, n * sizeof(T), alignof(T));
+                smart_ptr::detail::large_objects::instance().remove(n * sizeof(T));
+            }
+            else
+                ::operator delete(p, std::align_val_t(alignof(T)));
+        }
+
+
+        /**
+            Pool of the objects.
+        */
+
+        static smart_ptr::detail::slab_pool & pool()
+        {
+            return smart_ptr::detail::slab_pool::instance<sizeof(T), alignof(T), std::is_base_of<node_base, T>::value>();
+        }
+
+        template <typename U>
+            bool operator == (slab_allocator<U> const &) const
+            {
+                return true;
+            }
+
+        template <typename U>
+            bool operator != (slab_allocator<U> const &) const
+            {
+                return false;
+            }
+    };
+
+
+/**
+    Returns the slabs whose chunks are all free to the system.
+
+    @param  keep    Bytes of free slabs each pool keeps for later allocations.
+    @return         Bytes returned.
+*/
+
+inline std::size_t release_memory(std::size_t keep = 0)
+{
+    return smart_ptr::detail::slab_pool::release_all(keep);
+}
+
+
+#ifndef BOOST_DISABLE_THREADS
+/**
+    Background policy returning free slabs to the system periodically.
+
+    Bounds the memory held after bursts of allocations without calling @c release_memory() from 
+    the request path.
+*/
+
+class memory_trimmer
+{
+public:
+    /**
+        Starts trimming.
+
+        @param  period  Delay between two trims.
+        @param  keep    Bytes of free slabs each pool keeps for later allocations.
+    */
+
+    memory_trimmer(std::chrono::milliseconds period, std::size_t keep = 0)
+    : stop_(false)
+    , released_(0)
+    , thread_([this, period, keep]
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+
+        while (! condition_.wait_for(lock, period, [this] { return stop_; }))
+            released_ += release_memory(keep);
+    })
+    {
+    }
+
+    memory_trimmer(memory_trimmer const &) = delete;
+
+    ~memory_trimmer()
+    {
+        {
+            std::scoped_lock guard(mutex_);
+
+            stop_ = true;
+        }
+
+        condition_.notify_one();
+        thread_.join();
+    }
+
+
+    /**
+        Bytes returned to the system so far.
+    */
+
+    std::size_t released() const
+    {
+        return released_;
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    bool stop_;
+    std::atomic<std::size_t> released_;
+    std::thread thread_;
+};
+#endif
+
+
+} // namespace boost
+
+
+#endif // #ifndef BOOST_SLAB_ALLOCATOR_INCLUDED
@@ -0,0 +1,227 @@
+/*!
+    \file
+    \brief Boost trace.hpp header file.
+
+    Patent US11288049B2
+    'SOURCE TO SOURCE COMPILER, COMPILATION METHOD, AND
+    COMPUTER-READABLE MEDIUM FOR PREDICTABLE MEMORY MANAGEMENT'
+
+    Copyright (C) 2020-2026 Fornux LLC
+
+    Phil Bouchard, Founder & CEO
+    Fornux LLC
+    phil@fornux.com
+    3909 S Maryland Pkwy Ste 314 #638, Las Vegas, NV, 89119
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef BOOST_TRACE_INCLUDED
+#define BOOST_TRACE_INCLUDED
+
+
+#include <map>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <fstream>
+#include <iomanip>
+#include <algorithm>
+
+#include <boost/smart_ptr/root_ptr.hpp>
+#include <boost/smart_ptr/detail/tracer.hpp>
+
+
+namespace boost
+{
+
+
+/**
+    Sink writing the events to a binary file: a @c header followed by each @c trace_event as is, 
+    in the byte order of the machine.
+
+    Events are grouped by thread and only ordered in time within a thread.
+*/
+
+class trace_file : public trace_sink
+{
+public:
+    struct header
+    {
+        /** "RPTRACE1". */
+        char magic_[8];
+
+        /** Ticks per microsecond. */
+        double frequency_;
+
+        /** Time the file was opened at, in ticks. */
+        std::uint64_t origin_;
+    };
+
+
+    /**
+        Creates the file.
+
+        @param  path    File truncated.
+    */
+
+    explicit trace_file(char const * path)
+    : out_(path, std::ios::binary | std::ios::trunc)
+    {
+        header const h = {{'R', 'P', 'T', 'R', 'A', 'C', 'E', '1'}, trace_frequency(), trace_clock()};
+
+        out_.write(reinterpret_cast<char const *>(& h), sizeof(h));
+    }
+
+    ~trace_file()
+    {
+        if (smart_ptr::detail::tracer::sink().load() == this)
+            trace_to(nullptr);
+    }
+
+
+    void write(trace_event const * p, std::size_t n) override
+    {
+        out_.write(reinterpret_cast<char const *>(p), n * sizeof(trace_event));
+        out_.flush();
+    }
+
+
+    bool good() const
+    {
+        return out_.good();
+    }
+
+private:
+    std::ofstream out_;
+};
+
+
+/**
+    Converts a file written by @c trace_file to the JSON format of Chrome tracing, which can be 
+    loaded in @c chrome://tracing or Perfetto.
+
+    Allocations, deallocations and references are instant events, completed by a counter of the
+    bytes allocated during the trace.  Each @c node_proxy is an asynchronous slice and the phases 
+    of @c node_proxy::reset() are nested slices of its thread.
+
+    @param  in      Binary trace.
+    @param  out     JSON written.
+    @return         Whether the trace could be read.
+*/
+
+inline bool chrome_trace(std::istream & in, std::ostream & out)
+{
+    trace_file::header h;
+
+    if (! in.read(reinterpret_cast<char *>(& h), sizeof(h)) || std::memcmp(h.magic_, "RPTRACE1", sizeof(h.magic_)))
+        return false;
+
+    std::vector<trace_event> v;
+    trace_event e;
+
+    while (in.read(reinterpret_cast<char *>(& e), sizeof(e)))
+        v.push_back(e);
+
+    // threads are flushed one after the other
+    std::stable_sort(v.begin(), v.end(), [] (trace_event const & a, trace_event const & b) { return a.time_ < b.time_; });
+
+    // start and end of the last phase of each node_proxy::reset() in progress, by thread
+    std::map<std::uint32_t, std::vector<std::pair<double, double>>> resets;
+    std::int64_t live = 0;
+    char const * separator = "\n";
+
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[" << std::fixed << std::setprecision(3);
+
+    auto const event = [&] (char const * name, char const * category, char const * phase, double ts, trace_event const & e) -> std::ostream &
+    {
+        out << separator << "{\"name\":\"" << name << "\",\"cat\":\"" << category << "\",\"ph\":\"" << phase << "\",\"ts\":" << ts << ",\"pid\":1,\"tid\":" << e.thread_;
+        separator = ",\n";
+
+        return out;
+    };
+
+    auto const slice = [&] (char const * name, double ts, double end, trace_event const & e) -> std::ostream &
+    {
+        return event(name, "node_proxy", "X", ts, e) << ",\"dur\":" << end - ts;
+    };
+
+    for (trace_event const & e : v)
+    {
+        double const ts = std::int64_t(e.time_ - h.origin_) / h.frequency_;
+
+        switch (e.kind_)
+        {
+        case trace_kind::allocate:
+        case trace_kind::free:
+            live += e.kind_ == trace_kind::allocate ? std::int64_t(e.size_) : - std::int64_t(e.size_);
+
+            event(e.kind_ == trace_kind::allocate ? "allocate" : "free", "node", "i", ts, e) << ",\"s\":\"t\",\"args\":{\"address\":\"0x" << std::hex << e.address_ << std::dec << "\",\"size\":" << e.size_ << "}}";
+            event("live bytes", "node", "C", ts, e) << ",\"args\":{\"bytes\":" << live << "}}";
+            break;
+
+        case trace_kind::share:
+        case trace_kind::reset:
+            event(e.kind_ == trace_kind::share ? "share" : "reset", "root_ptr", "i", ts, e) << ",\"s\":\"t\",\"args\":{\"address\":\"0x" << std::hex << e.address_ << std::dec << "\"}}";
+            break;
+
+        case trace_kind::proxy_construct:
+        case trace_kind::proxy_destruct:
+            event("node_proxy", "node_proxy", e.kind_ == trace_kind::proxy_construct ? "b" : "e", ts, e) << ",\"id\":\"0x" << std::hex << e.address_ << std::dec << "\",\"args\":{\"depth\":" << e.size_ << "}}";
+            break;
+
+        case trace_kind::reset_begin:
+            resets[e.thread_].emplace_back(ts, ts);
+            break;
+
+        case trace_kind::reset_detached:
+        case trace_kind::reset_destroyed:
+        case trace_kind::reset_released:
+        {
+            std::vector<std::pair<double, double>> & s = resets[e.thread_];
+
+            // started before the trace
+            if (s.empty())
+                break;
+
+            if (e.kind_ == trace_kind::reset_detached)
+                slice("detach", s.back().second, ts, e) << ",\"args\":{\"pointers\":" << e.size_ << "}}";
+            else if (e.kind_ == trace_kind::reset_destroyed)
+                slice("destroy", s.back().second, ts, e) << ",\"args\":{\"nodes\":" << e.size_ << "}}";
+            else
+            {
+                slice("release", s.back().second, ts, e) << "}";
+                slice("node_proxy::reset", s.back().first, ts, e) << "}";
+            }
+
+            s.back().second = ts;
+
+            if (e.kind_ == trace_kind::reset_released)
+                s.pop_back();
+            break;
+        }
+        }
+    }
+
+    out << "\n]}\n";
+
+    return true;
+}
+
+
+} // namespace boost
+
+
+#endif // #ifndef BOOST_TRACE_INCLUDED
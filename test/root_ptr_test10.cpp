@@ -0,0 +1,126 @@
+/**
+	@file
+	root_ptr_test10.cpp
+
+	@note
+	Checking policies of root_ptr and root_array, and codegen of the unchecked dereference.
+
+	Distributed under the Boost Software License, Version 1.0.
+
+	See accompanying file LICENSE_1_0.txt or copy at
+	http://www.boost.org/LICENSE_1_0.txt
+*/
+
+
+#include <boost/smart_ptr/root_ptr.hpp>
+#include <boost/smart_ptr/root_stats.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <fstream>
+#include <iterator>
+#include <type_traits>
+
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#include <boost/test/unit_test.hpp>
+
+using namespace boost;
+
+static_assert(std::is_same<root_ptr<int>::checking_policy, checking::full>::value, "");
+static_assert(std::is_same<root_ptr<int[], checking::audit>::checking_policy, checking::audit>::value, "");
+
+#if defined(__GNUC__) && ! defined(__clang__) && defined(__ELF__)
+// each function alone in a section bounded by __start_ and __stop_ symbols
+#define ROOT_PTR_CODEGEN(s) __attribute__((noipa, section(#s)))
+#define ROOT_PTR_SECTION(s) std::string(__start_##s, __stop_##s)
+
+struct raw
+{
+    void * po_;
+    void const * pi_;
+};
+
+ROOT_PTR_CODEGEN(rp_load) int load(root_ptr<int, checking::unchecked> const & p)
+{
+    return * p;
+}
+
+ROOT_PTR_CODEGEN(rp_load_raw) int load_raw(raw const & p)
+{
+    return * static_cast<int const *>(p.pi_);
+}
+
+ROOT_PTR_CODEGEN(rp_index) int index(root_array<int, 8, checking::unchecked> const & p, int i)
+{
+    return p[i];
+}
+
+ROOT_PTR_CODEGEN(rp_index_raw) int index_raw(raw const & p, int i)
+{
+    return static_cast<int const *>(p.pi_)[i];
+}
+
+extern "C" char __start_rp_load[], __stop_rp_load[], __start_rp_load_raw[], __stop_rp_load_raw[];
+extern "C" char __start_rp_index[], __stop_rp_index[], __start_rp_index_raw[], __stop_rp_index_raw[];
+
+BOOST_AUTO_TEST_CASE(root_ptr_test10_codegen)
+{
+    // same machine code as a load through a raw pointer
+    BOOST_CHECK(ROOT_PTR_SECTION(rp_load) == ROOT_PTR_SECTION(rp_load_raw));
+    BOOST_CHECK(ROOT_PTR_SECTION(rp_index) == ROOT_PTR_SECTION(rp_index_raw));
+}
+#endif
+
+BOOST_AUTO_TEST_CASE(root_ptr_test10_policies)
+{
+    node_proxy x(__FILE__, "root_ptr_test10_policies", __LINE__);
+    root_ptr<int> p = make_root<int>(x, 7);
+    root_ptr<int, checking::unchecked> u = p;
+    root_ptr<int, checking::null_only> n(x);
+    root_ptr<int[]> a = make_root<int[]>(x, 4);
+    root_ptr<int[], checking::null_only> b = a;
+
+    BOOST_CHECK(u == p);
+    BOOST_CHECK_EQUAL(* u, 7);
+
+    std::uint64_t l = root_stats().locks_;
+    int s = 0;
+    for (int i = 0; i < 1000; ++ i)
+        s += * u;
+    BOOST_CHECK_EQUAL(root_stats().locks_, l);
+
+    for (int i = 0; i < 1000; ++ i)
+        s += * p;
+    BOOST_CHECK(root_stats().locks_ >= l + 1000);
+    BOOST_CHECK_EQUAL(s, 14000);
+
+    BOOST_CHECK_THROW(* n, root_error);
+    BOOST_CHECK_THROW(n += 1, root_error);
+    BOOST_CHECK_THROW(a[4], root_error);
+    BOOST_CHECK_NO_THROW(b[3]);
+
+    n = u;
+    BOOST_CHECK_EQUAL(* n, 7);
+}
+
+BOOST_AUTO_TEST_CASE(root_ptr_test10_audit)
+{
+    char const * path = "root_ptr_test10.json";
+    report_to(path);
+    {
+        node_proxy x(__FILE__, "root_ptr_test10_audit", __LINE__);
+        root_ptr<int[], checking::audit> a = make_root<int[]>(x, 4);
+        BOOST_CHECK_THROW(a[4], root_error);
+    }
+    flush_reports();
+
+    std::ifstream f(path);
+    std::string const s((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+    BOOST_CHECK(s.find("\"event\":\"out of bounds\"") != std::string::npos);
+    BOOST_CHECK(s.find("\"event\":\"memory leak\"") != std::string::npos);
+    std::remove(path);
+}
@@ -0,0 +1,119 @@
+/**
+	@file
+	root_ptr_test11.cpp
+
+	@note
+	Handles checked by generation.
+
+	Distributed under the Boost Software License, Version 1.0.
+
+	See accompanying file LICENSE_1_0.txt or copy at
+	http://www.boost.org/LICENSE_1_0.txt
+*/
+
+
+#define BOOST_SMART_PTR_HANDLES
+
+#include <boost/smart_ptr/root_ptr.hpp>
+#include <boost/smart_ptr/root_handle.hpp>
+
+#include <atomic>
+#include <string>
+#include <thread>
+
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#include <boost/test/unit_test.hpp>
+
+using namespace boost;
+
+static_assert(sizeof(root_handle<int>) == 8, "");
+
+BOOST_AUTO_TEST_CASE(root_ptr_test11_handle)
+{
+    root_handle<int> h;
+    BOOST_CHECK(! h);
+    BOOST_CHECK(h.get() == nullptr);
+
+    {
+        node_proxy x(__FILE__, "root_ptr_test11_handle", __LINE__);
+        root_ptr<int> p = make_root<int>(x, 7);
+        h = root_handle<int>(p);
+        BOOST_CHECK(h);
+        BOOST_CHECK_EQUAL(* h, 7);
+        BOOST_CHECK(h == root_handle<int>(p));
+
+        * h = 8;
+        BOOST_CHECK_EQUAL(* p, 8);
+
+        BOOST_CHECK(! root_handle<int>(root_ptr<int>(x)));
+        BOOST_CHECK_THROW(root_handle<int>(p + 1), root_error);
+    }
+
+    BOOST_CHECK(h.expired());
+    BOOST_CHECK(! h);
+    try {
+        * h;
+        BOOST_ERROR("no throw");
+    } catch (root_error const & e) {
+        BOOST_CHECK_EQUAL(e.kind(), root_error::use_after_free);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(root_ptr_test11_reuse)
+{
+    node_proxy x(__FILE__, "root_ptr_test11_reuse", __LINE__);
+    root_handle<int> h;
+    {
+        root_ptr<int> p = make_root<int>(x, 1);
+        h = root_handle<int>(p);
+    }
+    BOOST_CHECK(h.expired());
+
+    // the slot given back is taken again by the next node, under a new generation
+    root_ptr<int> q = make_root<int>(x, 2);
+    root_handle<int> g(q);
+    BOOST_CHECK(g != h);
+    BOOST_CHECK(h.expired());
+    BOOST_CHECK_EQUAL(* g, 2);
+
+    root_ptr<int[]> a = make_root<int[]>(x, 4);
+    root_handle<int> k(a);
+    BOOST_CHECK(k);
+    a[0] = 3;
+    BOOST_CHECK_EQUAL(* k, 3);
+}
+
+BOOST_AUTO_TEST_CASE(root_ptr_test11_race)
+{
+    node_proxy x(__FILE__, "root_ptr_test11_race", __LINE__);
+    std::size_t wrong = 0;
+    for (int i = 0; i < 100; ++i) {
+        root_ptr<int> p = make_root<int>(x, i);
+        int * const d = & * p;
+        root_handle<int> const h(p);
+        std::atomic<bool> started{false};
+        std::atomic<std::size_t> bad{0};
+
+        // either the pointee object or a throw, never a cleared pointer
+        std::thread t([&] {
+            for (;;) {
+                try {
+                    bad += h.get() != d;
+                } catch (root_error const &) {
+                    break;
+                }
+                started = true;
+            }
+        });
+        while (! started)
+            std::this_thread::yield();
+        p = root_ptr<int>(x);
+        t.join();
+        wrong += bad;
+        BOOST_CHECK(h.expired());
+    }
+    BOOST_CHECK_EQUAL(wrong, 0u);
+}
@@ -0,0 +1,115 @@
+/**
+	@file
+	root_ptr_test12.cpp
+
+	@note
+	Region of node_proxy and region_allocator.
+
+	Distributed under the Boost Software License, Version 1.0.
+
+	See accompanying file LICENSE_1_0.txt or copy at
+	http://www.boost.org/LICENSE_1_0.txt
+*/
+
+
+#include <boost/smart_ptr/root_ptr.hpp>
+#include <boost/smart_ptr/region_allocator.hpp>
+
+#include <vector>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#include <boost/test/unit_test.hpp>
+
+using namespace boost;
+
+typedef smart_ptr::detail::region region;
+
+BOOST_AUTO_TEST_CASE(root_ptr_test12_bump)
+{
+    node_proxy x(__FILE__, "root_ptr_test12_bump", __LINE__);
+    region_allocator<int> a(x);
+    BOOST_CHECK_EQUAL(x.region_.size(), 0u);
+
+    char * p = reinterpret_cast<char *>(a.allocate(1));
+    std::size_t const size = x.region_.size();
+    BOOST_CHECK(size >= region::chunk_size);
+    std::size_t const tail = x.region_.tail();
+
+    // rounded up to the size class, right after the previous block
+    char * q = reinterpret_cast<char *>(a.allocate(1));
+    BOOST_CHECK_EQUAL(q - p, std::ptrdiff_t(region::granularity));
+    char * r = reinterpret_cast<char *>(a.allocate(10));
+    BOOST_CHECK_EQUAL(r - q, std::ptrdiff_t(region::granularity));
+    BOOST_CHECK_EQUAL(x.region_.tail(), tail - region::granularity - 3 * region::granularity);
+    BOOST_CHECK_EQUAL(x.region_.size(), size);
+
+    // larger than a chunk: one of its own
+    a.allocate(region::chunk_size);
+    BOOST_CHECK(x.region_.size() >= size + region::chunk_size);
+}
+
+BOOST_AUTO_TEST_CASE(root_ptr_test12_reuse)
+{
+    node_proxy x(__FILE__, "root_ptr_test12_reuse", __LINE__);
+    region_allocator<int> a(x);
+
+    int * p = a.allocate(10);
+    int * q = a.allocate(1);
+    a.deallocate(p, 10);
+    BOOST_CHECK_EQUAL(x.region_.recycled(), 3 * region::granularity);
+    // same size class
+    BOOST_CHECK_EQUAL(a.allocate(12), p);
+    BOOST_CHECK_EQUAL(x.region_.recycled(), 0u);
+
+    // blocks keep being recycled once retired; only their wipe is deferred
+    x.region_.retire();
+    a.deallocate(q, 1);
+    BOOST_CHECK_EQUAL(x.region_.recycled(), region::granularity);
+    BOOST_CHECK_EQUAL(region_allocator<char>(a).allocate(region::granularity), reinterpret_cast<char *>(q));
+
+    // no recycling for blocks larger than the size classes
+    int * r = a.allocate(region::classes * region::granularity);
+    a.deallocate(r, region::classes * region::granularity);
+    BOOST_CHECK_EQUAL(x.region_.recycled(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(root_ptr_test12_release)
+{
+    node_proxy x(__FILE__, "root_ptr_test12_release", __LINE__);
+    region_allocator<int> a(x);
+
+    a.deallocate(a.allocate(1), 1);
+    a.allocate(2 * region::chunk_size);
+    BOOST_CHECK(x.region_.size() > 2 * region::chunk_size);
+
+    x.region_.release();
+    BOOST_CHECK_EQUAL(x.region_.size(), 0u);
+    BOOST_CHECK_EQUAL(x.region_.tail(), 0u);
+    BOOST_CHECK_EQUAL(x.region_.recycled(), 0u);
+
+    // starts over with a new chunk
+    a.allocate(1);
+    BOOST_CHECK(x.region_.size() >= region::chunk_size);
+    BOOST_CHECK(x.region_.size() < 2 * region::chunk_size);
+}
+
+struct holder {
+    holder(node_proxy const & x) : v(region_allocator<int>(x)) { }
+    std::vector<int, region_allocator<int>> v;
+};
+
+BOOST_AUTO_TEST_CASE(root_ptr_test12_reset)
+{
+    node_proxy x(__FILE__, "root_ptr_test12_reset", __LINE__);
+    root_ptr<holder> h = make_root<holder>(x, x);
+    h->v.resize(100000);
+    BOOST_CHECK(x.region_.size() >= 100000 * sizeof(int));
+    BOOST_CHECK(h->v.get_allocator() == region_allocator<int>(x));
+
+    // the container goes with its owner, then the region
+    x.reset();
+    BOOST_CHECK(! h);
+    BOOST_CHECK_EQUAL(x.region_.size(), 0u);
+}
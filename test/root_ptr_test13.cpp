@@ -0,0 +1,145 @@
+/**
+	@file
+	root_ptr_test13.cpp
+
+	@note
+	Nodes allocated from a std::pmr::memory_resource.
+
+	Distributed under the Boost Software License, Version 1.0.
+
+	See accompanying file LICENSE_1_0.txt or copy at
+	http://www.boost.org/LICENSE_1_0.txt
+*/
+
+
+#include <boost/smart_ptr/root_ptr.hpp>
+
+#include <vector>
+#include <memory_resource>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#include <boost/test/unit_test.hpp>
+
+using namespace boost;
+
+// counts the blocks going through an upstream resource
+struct counting_resource : std::pmr::memory_resource {
+    counting_resource(std::pmr::memory_resource * r) : upstream(r) { }
+
+    void * do_allocate(std::size_t n, std::size_t a) override {
+        void * p = upstream->allocate(n, a);
+        ++allocated;
+        bytes += n;
+        return p;
+    }
+    void do_deallocate(void * p, std::size_t n, std::size_t a) override {
+        ++deallocated;
+        bytes -= n;
+        upstream->deallocate(p, n, a);
+    }
+    bool do_is_equal(std::pmr::memory_resource const & r) const noexcept override {
+        return this == & r;
+    }
+
+    std::pmr::memory_resource * upstream;
+    std::size_t allocated = 0, deallocated = 0, bytes = 0;
+};
+
+struct item {
+    item(int i) : i(i) { }
+    int i;
+};
+
+BOOST_AUTO_TEST_CASE(root_ptr_test13_resource)
+{
+    char buffer[4096];
+    std::pmr::monotonic_buffer_resource m(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+    counting_resource r(& m);
+    {
+        node_proxy x(__FILE__, "root_ptr_test13_resource", __LINE__);
+        x.resource(& r);
+        BOOST_CHECK_EQUAL(x.resource(), & r);
+        {
+            root_ptr<item> p = make_root<item>(x, 7);
+            BOOST_CHECK_EQUAL(p->i, 7);
+            BOOST_CHECK_EQUAL(r.allocated, 1u);
+            BOOST_CHECK_EQUAL(r.bytes, sizeof(pmr_node<item>));
+            char const * q = reinterpret_cast<char const *>(static_cast<item *>(p));
+            BOOST_CHECK(q >= buffer && q < buffer + sizeof(buffer));
+        }
+        // destroyed through the resource it came from
+        BOOST_CHECK_EQUAL(r.deallocated, 1u);
+        BOOST_CHECK_EQUAL(r.bytes, 0u);
+
+        root_ptr<int[]> a = make_root<int[]>(x, 10);
+        BOOST_CHECK_EQUAL(r.allocated, 2u);
+        BOOST_CHECK_EQUAL(a.size(), 10u);
+
+        // inherited by children
+        node_proxy y(__FILE__, "root_ptr_test13_resource", __LINE__, & x);
+        root_ptr<item> b = make_root<item>(y, 1);
+        BOOST_CHECK_EQUAL(r.allocated, 3u);
+    }
+    BOOST_CHECK_EQUAL(r.deallocated, 3u);
+    BOOST_CHECK_EQUAL(r.bytes, 0u);
+}
+
+BOOST_AUTO_TEST_CASE(root_ptr_test13_exhausted)
+{
+    char buffer[256];
+    std::pmr::monotonic_buffer_resource m(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+    counting_resource r(& m);
+    node_proxy x(__FILE__, "root_ptr_test13_exhausted", __LINE__);
+    x.resource(& r);
+
+    std::vector<root_ptr<item>> v;
+    BOOST_CHECK_THROW(for (;;) v.push_back(make_root<item>(x, 0)), std::bad_alloc);
+    BOOST_CHECK_EQUAL(r.allocated, v.size());
+    v.clear();
+    BOOST_CHECK_EQUAL(r.bytes, 0u);
+}
+
+BOOST_AUTO_TEST_CASE(root_ptr_test13_allocator)
+{
+    char buffer[4096];
+    std::pmr::monotonic_buffer_resource m(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+    counting_resource r(& m);
+    node_proxy x(__FILE__, "root_ptr_test13_allocator", __LINE__);
+    {
+        root_ptr<item> p = allocate_root<item>(x, std::pmr::polymorphic_allocator<item>(& r), 3);
+        BOOST_CHECK_EQUAL(p->i, 3);
+        BOOST_CHECK_EQUAL(r.allocated, 1u);
+    }
+    BOOST_CHECK_EQUAL(r.deallocated, 1u);
+}
+
+BOOST_AUTO_TEST_CASE(root_ptr_test13_make_nodes)
+{
+    char buffer[4096];
+    std::pmr::monotonic_buffer_resource m(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+    counting_resource r(& m);
+    memory_quota q;
+    {
+        node_proxy x(__FILE__, "root_ptr_test13_make_nodes", __LINE__);
+        x.resource(& r);
+        x.quota(& q);
+        std::vector<root_ptr<item>> v = make_nodes<item>(x, 10, 5);
+        BOOST_CHECK_EQUAL(r.allocated, 10u);
+        BOOST_CHECK_EQUAL(r.bytes, 10 * sizeof(pmr_node<item>));
+        BOOST_CHECK_EQUAL(q.objects(), 10u);
+        for (root_ptr<item> & p : v) {
+            BOOST_CHECK_EQUAL(p->i, 5);
+            char const * c = reinterpret_cast<char const *>(static_cast<item *>(p));
+            BOOST_CHECK(c >= buffer && c < buffer + sizeof(buffer));
+        }
+
+        // whatever was made is returned when the resource runs out
+        BOOST_CHECK_THROW(make_nodes<item>(x, 1000, 0), std::bad_alloc);
+        BOOST_CHECK_EQUAL(r.bytes, 10 * sizeof(pmr_node<item>));
+        BOOST_CHECK_EQUAL(q.objects(), 10u);
+    }
+    BOOST_CHECK_EQUAL(r.bytes, 0u);
+    BOOST_CHECK_EQUAL(q.objects(), 0u);
+}
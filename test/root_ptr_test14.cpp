@@ -0,0 +1,233 @@
+/**
+	@file
+	root_ptr_test14.cpp
+
+	@note
+	Factories of nodes.
+
+	Distributed under the Boost Software License, Version 1.0.
+
+	See accompanying file LICENSE_1_0.txt or copy at
+	http://www.boost.org/LICENSE_1_0.txt
+*/
+
+
+#include <boost/smart_ptr/root_ptr.hpp>
+#include <boost/smart_ptr/root_stats.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <initializer_list>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#include <boost/test/unit_test.hpp>
+
+using namespace boost;
+
+static int live, countdown = -1;
+static std::size_t allocations, deallocations;
+
+struct fragile {
+    fragile(bool fail = false) { if (fail || countdown -- == 0) throw std::runtime_error("fragile"); ++live; }
+    ~fragile() { --live; }
+    char data[64];
+};
+
+template <typename T>
+    struct counting_allocator : std::allocator<T> {
+        template <typename U>
+            struct rebind { typedef counting_allocator<U> other; };
+
+        counting_allocator() = default;
+        template <typename U>
+            counting_allocator(counting_allocator<U> const &) { }
+
+        T * allocate(std::size_t n) { ++allocations; return std::allocator<T>::allocate(n); }
+        void deallocate(T * p, std::size_t n) { ++deallocations; std::allocator<T>::deallocate(p, n); }
+    };
+
+BOOST_AUTO_TEST_CASE(root_ptr_test14_throw)
+{
+    smart_ptr::detail::slab_pool & pool = slab_allocator<node<fragile>>::pool();
+    memory_quota q;
+    node_proxy x(__FILE__, "root_ptr_test14_throw", __LINE__);
+    x.quota(& q);
+
+    root_ptr<fragile> p = make_root<fragile>(x);
+    std::size_t const n = pool.live();
+    BOOST_CHECK_THROW(make_root<fragile>(x, true), std::runtime_error);
+    BOOST_CHECK_EQUAL(pool.live(), n);
+    BOOST_CHECK_EQUAL(q.objects(), 1u);
+    BOOST_CHECK_EQUAL(q.bytes(), sizeof(node<fragile>));
+    BOOST_CHECK_EQUAL(live, 1);
+
+    BOOST_CHECK_THROW(allocate_root<fragile>(x, counting_allocator<fragile>(), true), std::runtime_error);
+    BOOST_CHECK_EQUAL(allocations, 1u);
+    BOOST_CHECK_EQUAL(deallocations, 1u);
+    BOOST_CHECK_EQUAL(q.objects(), 1u);
+    {
+        root_ptr<fragile> r = allocate_root<fragile>(x, counting_allocator<fragile>());
+        BOOST_CHECK_EQUAL(allocations, 2u);
+        BOOST_CHECK_EQUAL(q.objects(), 2u);
+    }
+    BOOST_CHECK_EQUAL(deallocations, 2u);
+    BOOST_CHECK_EQUAL(q.objects(), 1u);
+    BOOST_CHECK_EQUAL(live, 1);
+}
+
+BOOST_AUTO_TEST_CASE(root_ptr_test14_make_nodes)
+{
+    smart_ptr::detail::slab_pool & pool = slab_allocator<node<fragile>>::pool();
+    memory_quota q;
+    node_proxy x(__FILE__, "root_ptr_test14_make_nodes", __LINE__);
+    x.quota(& q);
+
+    std::size_t const n = pool.live();
+    countdown = 50;
+    BOOST_CHECK_THROW(make_nodes<fragile>(x, 100), std::runtime_error);
+    BOOST_CHECK_EQUAL(pool.live(), n);
+    BOOST_CHECK_EQUAL(live, 0);
+    BOOST_CHECK_EQUAL(q.objects(), 0u);
+    BOOST_CHECK_EQUAL(q.bytes(), 0u);
+
+    std::vector<root_ptr<fragile>> v = make_nodes<fragile>(x, 100);
+    BOOST_CHECK_EQUAL(pool.live(), n + 100);
+    BOOST_CHECK_EQUAL(live, 100);
+    BOOST_CHECK_EQUAL(q.objects(), 100u);
+    v.clear();
+    BOOST_CHECK_EQUAL(pool.live(), n);
+    BOOST_CHECK_EQUAL(q.objects(), 0u);
+}
+
+struct both {
+    both(int n, int) : n(n), list(false) { }
+    both(std::initializer_list<int> l) : n(int(l.size())), list(true) { }
+    int n;
+    bool list;
+};
+
+struct aggregate {
+    int i;
+    double d;
+};
+
+BOOST_AUTO_TEST_CASE(root_ptr_test14_dispatch)
+{
+    node_proxy x(__FILE__, "root_ptr_test14_dispatch", __LINE__);
+
+    // parentheses whenever a constructor matches
+    root_ptr<both> b = make_root<both>(x, 5, 0);
+    BOOST_CHECK(! b->list);
+    BOOST_CHECK_EQUAL(b->n, 5);
+    root_ptr<std::string> s = make_root<std::string>(x, 3u, 'a');
+    BOOST_CHECK_EQUAL(* s, "aaa");
+
+    // braces for aggregates
+    root_ptr<aggregate> a = make_root<aggregate>(x, 1, 2.5);
+    BOOST_CHECK_EQUAL(a->i, 1);
+    BOOST_CHECK_EQUAL(a->d, 2.5);
+    root_ptr<aggregate> z = make_root<aggregate>(x);
+    BOOST_CHECK_EQUAL(z->i, 0);
+
+    // same with an allocator
+    root_ptr<both> c = allocate_root<both>(x, std::allocator<both>(), 7, 0);
+    BOOST_CHECK(! c->list);
+    BOOST_CHECK_EQUAL(c->n, 7);
+    root_ptr<aggregate> d = allocate_root<aggregate>(x, std::allocator<aggregate>(), 3, 0.5);
+    BOOST_CHECK_EQUAL(d->i, 3);
+}
+
+BOOST_AUTO_TEST_CASE(root_ptr_test14_array_throw)
+{
+    memory_quota q;
+    node_proxy x(__FILE__, "root_ptr_test14_array_throw", __LINE__);
+    x.quota(& q);
+
+    // the elements built so far are destroyed and the node returned
+    std::uint64_t const bytes = root_stats().live_bytes();
+    countdown = 5;
+    BOOST_CHECK_THROW(make_root<fragile[]>(x, 10), std::runtime_error);
+    BOOST_CHECK_EQUAL(live, 0);
+    BOOST_CHECK_EQUAL(root_stats().live_bytes(), bytes);
+    BOOST_CHECK_EQUAL(q.bytes(), 0u);
+
+    allocations = deallocations = 0;
+    countdown = 5;
+    BOOST_CHECK_THROW(allocate_root<fragile[]>(x, counting_allocator<fragile>(), 10), std::runtime_error);
+    BOOST_CHECK_EQUAL(live, 0);
+    BOOST_CHECK_EQUAL(allocations, 1u);
+    BOOST_CHECK_EQUAL(deallocations, 1u);
+    BOOST_CHECK_EQUAL(q.bytes(), 0u);
+
+    {
+        root_ptr<fragile[]> a = allocate_root<fragile[]>(x, counting_allocator<fragile>(), 10);
+        BOOST_CHECK_EQUAL(live, 10);
+        BOOST_CHECK_EQUAL(a.size(), 10u);
+    }
+    BOOST_CHECK_EQUAL(live, 0);
+    BOOST_CHECK_EQUAL(deallocations, 2u);
+}
+
+BOOST_AUTO_TEST_CASE(root_ptr_test14_array_size)
+{
+    node_proxy x(__FILE__, "root_ptr_test14_array_size", __LINE__);
+
+    root_ptr<int[]> a = make_root<int[]>(x, 10, 7);
+    BOOST_CHECK_EQUAL(a.size(), 10u);
+    BOOST_CHECK_EQUAL(a[0], 7);
+    BOOST_CHECK_EQUAL(a[9], 7);
+
+    // from the pointer to the end of the array
+    root_ptr<int[]> b(a);
+    b += 3;
+    BOOST_CHECK_EQUAL(b.size(), 7u);
+    b += 7;
+    BOOST_CHECK_EQUAL(b.size(), 0u);
+    b -= 11;
+    BOOST_CHECK_EQUAL(b.size(), 0u);
+
+    BOOST_CHECK_EQUAL(make_root<int[]>(x, 0).size(), 0u);
+    BOOST_CHECK_EQUAL(root_ptr<int[]>(x).size(), 0u);
+
+    // elements laid out right after the node
+    root_ptr<std::string[]> s = make_root<std::string[]>(x, 3, "abc");
+    BOOST_CHECK_EQUAL(s.size(), 3u);
+    BOOST_CHECK_EQUAL(s[2], "abc");
+    BOOST_CHECK_EQUAL(& s[2] - & s[0], 2);
+}
+
+BOOST_AUTO_TEST_CASE(root_ptr_test14_array_bounds)
+{
+    node_proxy x(__FILE__, "root_ptr_test14_array_bounds", __LINE__);
+
+    root_ptr<int[]> a = make_root<int[]>(x, 10);
+    root_ptr<int[]> const & c = a;
+    a[9] = 1;
+    BOOST_CHECK_EQUAL(c[9], 1);
+    try {
+        a[10] = 0;
+        BOOST_ERROR("no throw");
+    } catch (root_error const & e) {
+        BOOST_CHECK_EQUAL(e.kind(), root_error::out_of_bounds);
+        BOOST_CHECK_EQUAL(e.index(), 10);
+        BOOST_CHECK_EQUAL(e.bound(), 10u);
+    }
+    BOOST_CHECK_THROW(c[10], root_error);
+    BOOST_CHECK_THROW(a[-1], root_error);
+
+    root_ptr<int[]> b(a);
+    b += 8;
+    BOOST_CHECK_EQUAL(b[1], 1);
+    BOOST_CHECK_THROW(b[2], root_error);
+
+    root_ptr<int[]> n(x);
+    BOOST_CHECK_THROW(n[0], root_error);
+
+    // not checked by the policy
+    root_ptr<int[], checking::unchecked> u(a);
+    BOOST_CHECK_EQUAL(& u[10], & c[9] + 1);
+}
@@ -0,0 +1,90 @@
+/**
+	@file
+	root_ptr_test15.cpp
+
+	@note
+	Over-aligned pointee objects on each backend.
+
+	Distributed under the Boost Software License, Version 1.0.
+
+	See accompanying file LICENSE_1_0.txt or copy at
+	http://www.boost.org/LICENSE_1_0.txt
+*/
+
+
+#include <boost/smart_ptr/root_ptr.hpp>
+#include <boost/smart_ptr/region_allocator.hpp>
+
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <memory_resource>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#include <boost/test/unit_test.hpp>
+
+using namespace boost;
+
+struct alignas(64) line {
+    char data[64];
+};
+
+struct alignas(4096) page {
+    char data[100];
+};
+
+template <typename T>
+    bool aligned(T const * p)
+    {
+        return reinterpret_cast<std::uintptr_t>(p) % alignof(T) == 0;
+    }
+
+template <typename T>
+    void check(node_proxy const & x)
+    {
+        std::vector<root_ptr<T>> v;
+        for (int i = 0; i < 10; ++i) {
+            // slab
+            v.push_back(make_root<T>(x));
+            // region
+            v.push_back(allocate_root<T>(x, region_allocator<T>(x)));
+            // operator new
+            v.push_back(allocate_root<T>(x, std::allocator<T>()));
+            // Boost pools
+            v.push_back(allocate_root<T>(x, pool_allocator<T>()));
+            v.push_back(allocate_root<T>(x, fast_pool_allocator<T>()));
+            // memory resource
+            v.push_back(allocate_root<T>(x, std::pmr::polymorphic_allocator<T>()));
+        }
+        for (root_ptr<T> & p : v)
+            BOOST_CHECK(aligned(static_cast<T *>(p)));
+
+        // arrays of runtime size
+        for (int i = 0; i < 10; ++i) {
+            root_ptr<T[]> a = make_root<T[]>(x, 3);
+            BOOST_CHECK(aligned(& a[0]));
+            BOOST_CHECK(aligned(& a[2]));
+            root_ptr<T[]> b = allocate_root<T[]>(x, region_allocator<T>(x), 3);
+            BOOST_CHECK(aligned(& b[0]));
+            root_ptr<T[]> c = allocate_root<T[]>(x, std::allocator<T>(), 3);
+            BOOST_CHECK(aligned(& c[0]));
+        }
+    }
+
+BOOST_AUTO_TEST_CASE(root_ptr_test15_line)
+{
+    node_proxy x(__FILE__, "root_ptr_test15_line", __LINE__);
+    check<line>(x);
+}
+
+BOOST_AUTO_TEST_CASE(root_ptr_test15_page)
+{
+    node_proxy x(__FILE__, "root_ptr_test15_page", __LINE__);
+    check<page>(x);
+
+    std::vector<root_ptr<page>> v = make_nodes<page>(x, 10);
+    for (root_ptr<page> & p : v)
+        BOOST_CHECK(aligned(static_cast<page *>(p)));
+}
@@ -0,0 +1,154 @@
+/**
+	@file
+	root_ptr_test16.cpp
+
+	@note
+	Freed memory wiped with zeros, and its interaction with the quarantine and huge pages.
+
+	Distributed under the Boost Software License, Version 1.0.
+
+	See accompanying file LICENSE_1_0.txt or copy at
+	http://www.boost.org/LICENSE_1_0.txt
+*/
+
+
+#define BOOST_ZEROIZATION
+#define BOOST_SMART_PTR_QUARANTINE
+
+#include <boost/smart_ptr/root_ptr.hpp>
+#include <boost/smart_ptr/region_allocator.hpp>
+
+#include <cstring>
+#include <utility>
+#include <vector>
+#include <algorithm>
+#include <type_traits>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#include <boost/test/unit_test.hpp>
+
+using namespace boost;
+
+typedef std::pair<unsigned char *, std::size_t> block;
+
+alignas(std::max_align_t) static unsigned char arena[1 << 16];
+static std::size_t used;
+static std::vector<block> allocated, freed;
+
+// never reuses its memory so that freed blocks can be read back
+template <typename T, bool Stateless>
+    struct keeping_allocator {
+        typedef T value_type;
+        typedef std::integral_constant<bool, Stateless> is_always_equal;
+
+        template <typename U>
+            struct rebind { typedef keeping_allocator<U, Stateless> other; };
+
+        keeping_allocator() = default;
+        template <typename U>
+            keeping_allocator(keeping_allocator<U, Stateless> const &) { }
+
+        T * allocate(std::size_t n) {
+            used = (used + alignof(T) - 1) / alignof(T) * alignof(T);
+            allocated.emplace_back(arena + used, n * sizeof(T));
+            used += n * sizeof(T);
+            return reinterpret_cast<T *>(allocated.back().first);
+        }
+        void deallocate(T * p, std::size_t n) {
+            freed.emplace_back(reinterpret_cast<unsigned char *>(p), n * sizeof(T));
+        }
+
+        template <typename U>
+            bool operator == (keeping_allocator<U, Stateless> const &) const { return true; }
+        template <typename U>
+            bool operator != (keeping_allocator<U, Stateless> const &) const { return false; }
+    };
+
+static bool filled(block const & b, unsigned char c)
+{
+    return std::all_of(b.first, b.first + b.second, [c](unsigned char i) { return i == c; });
+}
+
+struct secret {
+    secret() { std::memset(data, 0x5a, sizeof(data)); }
+    unsigned char data[100];
+};
+
+BOOST_AUTO_TEST_CASE(root_ptr_test16_zeroize)
+{
+    // stateful allocators are not quarantined: wiped when destroyed
+    typedef keeping_allocator<secret, false> allocator;
+    node_proxy x(__FILE__, "root_ptr_test16_zeroize", __LINE__);
+    freed.clear();
+
+    {
+        root_ptr<secret> p = allocate_root<secret>(x, allocator());
+        BOOST_CHECK_EQUAL(p->data[0], 0x5a);
+    }
+    BOOST_REQUIRE_EQUAL(freed.size(), 1u);
+    BOOST_CHECK_EQUAL(freed[0].first, allocated.back().first);
+    BOOST_CHECK(filled(freed[0], 0));
+
+    {
+        root_ptr<secret[]> a = allocate_root<secret[]>(x, allocator(), 3);
+    }
+    BOOST_REQUIRE_EQUAL(freed.size(), 2u);
+    BOOST_CHECK_EQUAL(freed[1].second, allocated.back().second);
+    BOOST_CHECK(filled(freed[1], 0));
+
+    // destroyed by a reset
+    root_ptr<secret> q(x);
+    q = allocate_root<secret>(x, allocator());
+    x.reset();
+    BOOST_REQUIRE_EQUAL(freed.size(), 3u);
+    BOOST_CHECK(filled(freed[2], 0));
+}
+
+BOOST_AUTO_TEST_CASE(root_ptr_test16_quarantine)
+{
+    typedef keeping_allocator<secret, true> allocator;
+    node_proxy x(__FILE__, "root_ptr_test16_quarantine", __LINE__);
+    flush_quarantine();
+    freed.clear();
+
+    {
+        root_ptr<secret> p = allocate_root<secret>(x, allocator());
+        root_ptr<secret[]> a = allocate_root<secret[]>(x, allocator(), 3);
+    }
+    // held poisoned: the secret is gone but the memory not returned yet
+    BOOST_CHECK(freed.empty());
+    BOOST_CHECK(filled(allocated.end()[-2], smart_ptr::detail::quarantine::poison));
+    BOOST_CHECK(filled(allocated.end()[-1], smart_ptr::detail::quarantine::poison));
+
+    // wiped on its way back to the allocator
+    flush_quarantine();
+    BOOST_REQUIRE_EQUAL(freed.size(), 2u);
+    BOOST_CHECK(filled(freed[0], 0));
+    BOOST_CHECK(filled(freed[1], 0));
+
+    // too large for the quarantine: wiped and returned right away
+    quarantine_limit(0);
+    {
+        root_ptr<secret> p = allocate_root<secret>(x, allocator());
+    }
+    BOOST_REQUIRE_EQUAL(freed.size(), 3u);
+    BOOST_CHECK(filled(freed[2], 0));
+    quarantine_limit(BOOST_SMART_PTR_QUARANTINE_BYTES);
+}
+
+BOOST_AUTO_TEST_CASE(root_ptr_test16_region)
+{
+    // chunks are wiped but for the header telling how to return them
+    for (bool huge : {false, true}) {
+        node_proxy x(__FILE__, "root_ptr_test16_region", __LINE__);
+        x.huge_pages(huge);
+        std::vector<int, region_allocator<int>> v{region_allocator<int>(x)};
+        v.resize(100000, 1);
+        BOOST_CHECK(x.region_.size() > 0);
+        v = std::vector<int, region_allocator<int>>{region_allocator<int>(x)};
+        x.reset();
+        BOOST_CHECK_EQUAL(x.region_.size(), 0u);
+    }
+}
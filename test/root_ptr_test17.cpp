@@ -0,0 +1,90 @@
+/**
+	@file
+	root_ptr_test17.cpp
+
+	@note
+	Huge pages backing regions and slab pools, falling back to normal pages when none are
+	available.
+
+	Distributed under the Boost Software License, Version 1.0.
+
+	See accompanying file LICENSE_1_0.txt or copy at
+	http://www.boost.org/LICENSE_1_0.txt
+*/
+
+
+#define BOOST_SMART_PTR_HUGE_PAGES
+
+#include <boost/smart_ptr/root_ptr.hpp>
+#include <boost/smart_ptr/region_allocator.hpp>
+
+#include <vector>
+#include <cstdint>
+#include <cstring>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#include <boost/test/unit_test.hpp>
+
+using namespace boost;
+using namespace boost::smart_ptr::detail;
+
+static bool aligned(void const * p, std::size_t a)
+{
+    return reinterpret_cast<std::uintptr_t>(p) % a == 0;
+}
+
+BOOST_AUTO_TEST_CASE(root_ptr_test17_map)
+{
+    // without reserved huge pages (vm.nr_hugepages) the mapping falls back to normal pages
+    void * p = nullptr;
+    BOOST_CHECK_NO_THROW(p = map_pages(huge_page_size, page_size, true));
+    BOOST_REQUIRE(p);
+    BOOST_CHECK(aligned(p, huge_page_size));
+    std::memset(p, 1, huge_page_size);
+    unmap_pages(p, huge_page_size, page_size);
+
+    // aligned beyond a huge page: never taken from the reserved pool
+    BOOST_CHECK_NO_THROW(p = map_pages(2 * huge_page_size, 2 * huge_page_size, true));
+    BOOST_CHECK(aligned(p, 2 * huge_page_size));
+    fault_pages(p, 2 * huge_page_size);
+    unmap_pages(p, 2 * huge_page_size, 2 * huge_page_size);
+
+    BOOST_CHECK_NO_THROW(p = map_pages(page_size, page_size));
+    BOOST_CHECK(aligned(p, page_size));
+    unmap_pages(p, page_size, page_size);
+}
+
+BOOST_AUTO_TEST_CASE(root_ptr_test17_region)
+{
+    node_proxy x(__FILE__, "root_ptr_test17_region", __LINE__);
+    x.huge_pages(true);
+
+    std::vector<int, region_allocator<int>> v{region_allocator<int>(x)};
+    BOOST_CHECK_NO_THROW(v.resize(100000, 1));
+    BOOST_CHECK(x.region_.size() > 0);
+    BOOST_CHECK_EQUAL(x.region_.size() % huge_page_size, 0u);
+    BOOST_CHECK_EQUAL(v.back(), 1);
+    v = std::vector<int, region_allocator<int>>{region_allocator<int>(x)};
+    x.reset();
+    BOOST_CHECK_EQUAL(x.region_.size(), 0u);
+}
+
+struct item {
+    char data[100];
+};
+
+BOOST_AUTO_TEST_CASE(root_ptr_test17_slab)
+{
+    slab_pool & pool = slab_allocator<node<item>>::pool();
+    node_proxy x(__FILE__, "root_ptr_test17_slab", __LINE__);
+
+    std::vector<root_ptr<item>> v;
+    BOOST_CHECK_NO_THROW(for (int i = 0; i < 100000; ++i) v.push_back(make_root<item>(x)));
+    BOOST_CHECK(pool.size() >= 100000 * sizeof(node<item>));
+    BOOST_CHECK_EQUAL(pool.size() % huge_page_size, 0u);
+    v.clear();
+    release_memory();
+    BOOST_CHECK_EQUAL(pool.live(), 0u);
+}
@@ -0,0 +1,63 @@
+/**
+	@file
+	root_ptr_test18.cpp
+
+	@note
+	Heap profile by call site of node_proxy.
+
+	Distributed under the Boost Software License, Version 1.0.
+
+	See accompanying file LICENSE_1_0.txt or copy at
+	http://www.boost.org/LICENSE_1_0.txt
+*/
+
+
+#define BOOST_SMART_PTR_HEAP_PROFILE
+
+#include <boost/smart_ptr/root_ptr.hpp>
+#include <boost/smart_ptr/heap_profile.hpp>
+
+#include <string>
+#include <vector>
+#include <sstream>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#include <boost/test/unit_test.hpp>
+
+using namespace boost;
+
+static void grow(node_proxy const & x, std::vector<root_ptr<int>> & v)
+{
+    node_proxy y(__FILE__, "grow", __LINE__, & x);
+    for (int i = 0; i < 10; ++i)
+        v.push_back(make_root<int>(y, i));
+}
+
+BOOST_AUTO_TEST_CASE(root_ptr_test18_profile)
+{
+    node_proxy x(__FILE__, "root_ptr_test18_profile", __LINE__);
+    std::vector<root_ptr<int>> v;
+    grow(x, v);
+    grow(x, v);
+
+    heap_profile p;
+    std::ostringstream s;
+    p.folded(s);
+    BOOST_CHECK(s.str().find(";grow (") != std::string::npos);
+
+    std::size_t n = 0;
+    for (heap_profile::site const & i : p.sites())
+        if (i.frames_.size() == 2 && i.frames_[1]->function_ == std::string("root_ptr_test18_profile"))
+        {
+            n += i.count_;
+            BOOST_CHECK_EQUAL(i.bytes_, i.count_ * sizeof(node<int>));
+        }
+    BOOST_CHECK_EQUAL(n, 20u);
+
+    v.clear();
+    heap_profile const r;
+    for (heap_profile::site const & i : r.sites())
+        BOOST_CHECK(i.frames_.size() != 2 || i.frames_[1]->function_ != std::string("root_ptr_test18_profile"));
+}
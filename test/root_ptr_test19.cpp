@@ -0,0 +1,74 @@
+/**
+	@file
+	root_ptr_test19.cpp
+
+	@note
+	Errors thrown by failed checks.
+
+	Distributed under the Boost Software License, Version 1.0.
+
+	See accompanying file LICENSE_1_0.txt or copy at
+	http://www.boost.org/LICENSE_1_0.txt
+*/
+
+
+#include <boost/smart_ptr/root_ptr.hpp>
+
+#include <string>
+#include <stdexcept>
+#include <type_traits>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#include <boost/test/unit_test.hpp>
+
+using namespace boost;
+
+BOOST_AUTO_TEST_CASE(root_ptr_test19_error)
+{
+    node_proxy x(__FILE__, "root_ptr_test19_error", __LINE__);
+    node_proxy y(__FILE__, "inner", __LINE__, & x);
+    root_ptr<int[]> p = make_root<int[]>(y, 4);
+
+    try {
+        p[4] = 0;
+        BOOST_ERROR("no throw");
+    } catch (std::out_of_range const & e) {
+        root_error const * r = dynamic_cast<root_error const *>(& e);
+        BOOST_REQUIRE(r);
+        BOOST_CHECK_EQUAL(r->kind(), root_error::out_of_bounds);
+        BOOST_CHECK_EQUAL(r->index(), 4);
+        BOOST_CHECK_EQUAL(r->bound(), 4u);
+        std::string s = e.what();
+        BOOST_CHECK(s.find("index 4 out of range [0, 4[\n#0 inner in ") == 0);
+        BOOST_CHECK(s.find("#1 root_ptr_test19_error in ") == std::string::npos);
+    }
+
+    root_ptr<int> q(y);
+    BOOST_CHECK_THROW(* q, root_error);
+}
+
+BOOST_AUTO_TEST_CASE(root_ptr_test19_record)
+{
+    static_assert(std::is_nothrow_constructible<root_error, root_error::kind_type>::value, "");
+    static_assert(std::is_nothrow_copy_constructible<root_error>::value, "");
+
+    root_error e(root_error::null_pointer);
+    BOOST_CHECK_EQUAL(e.what(), "null pointer\n");
+
+    // innermost frames only
+    root_error f(root_error::out_of_bounds, 7, 3);
+    for (int i = 0; i < root_error::frames + 4; ++i)
+        f.push("file", "function", i);
+    std::string const s = f.what();
+    BOOST_CHECK(s.find("index 7 out of range [0, 3[\n#0 function in file line 0\n") == 0);
+    BOOST_CHECK(s.find("#15 function in file line 15\n") != std::string::npos);
+    BOOST_CHECK(s.find("#16 ") == std::string::npos);
+
+    // the message survives copies
+    root_error const g(f);
+    BOOST_CHECK_EQUAL(std::string(g.what()), s);
+    BOOST_CHECK_EQUAL(g.index(), 7);
+    BOOST_CHECK_EQUAL(static_cast<std::out_of_range const &>(g).std::out_of_range::what(), std::string("root_ptr"));
+}
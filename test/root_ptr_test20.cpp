@@ -0,0 +1,130 @@
+/**
+	@file
+	root_ptr_test20.cpp
+
+	@note
+	Graph dumps of a node_proxy.
+
+	Distributed under the Boost Software License, Version 1.0.
+
+	See accompanying file LICENSE_1_0.txt or copy at
+	http://www.boost.org/LICENSE_1_0.txt
+*/
+
+
+#include <boost/smart_ptr/root_ptr.hpp>
+#include <boost/smart_ptr/graph_dump.hpp>
+
+#include <string>
+#include <sstream>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#include <boost/test/unit_test.hpp>
+
+using namespace boost;
+
+static std::string quoted(void const * p)
+{
+    std::ostringstream s;
+    s << '"' << p << '"';
+    return s.str();
+}
+
+struct vertex {
+    vertex(node_proxy const & x) : next(x) { }
+    root_ptr<vertex> next;
+};
+
+BOOST_AUTO_TEST_CASE(root_ptr_test20_graph)
+{
+    node_proxy x(__FILE__, "root_ptr_test20_graph", __LINE__);
+    root_ptr<vertex> a = make_root<vertex>(x, x);
+    root_ptr<vertex> b = make_root<vertex>(x, x);
+    a->next = b;
+    b->next = a;
+
+    std::ostringstream p, q, r, s;
+    p << static_cast<void const *>(static_cast<vertex *>(a));
+    q << static_cast<void const *>(static_cast<vertex *>(b));
+    r << static_cast<void const *>(& x);
+    std::string const u = "\"" + p.str() + "\"", v = "\"" + q.str() + "\"", w = "\"" + r.str() + "\"";
+
+    dump_graph(x, s);
+    BOOST_CHECK(s.str().find("digraph") == 0);
+    BOOST_CHECK(s.str().find(u + " -> " + v) != std::string::npos);
+    BOOST_CHECK(s.str().find(v + " -> " + u) != std::string::npos);
+    BOOST_CHECK(s.str().find(w + " -> " + u) != std::string::npos);
+    BOOST_CHECK(s.str().find(w + " -> " + v) != std::string::npos);
+
+    s.str("");
+    dump_graph(x, s, graph_format::ndjson);
+    std::size_t nodes = 0, edges = 0;
+    std::istringstream in(s.str());
+    for (std::string l; std::getline(in, l); ) {
+        nodes += l.find("{\"node\":") == 0;
+        edges += l.find("{\"edge\":") == 0;
+    }
+    BOOST_CHECK_EQUAL(nodes, 2u);
+    BOOST_CHECK_EQUAL(edges, 4u);
+    BOOST_CHECK(s.str().find("{\"edge\":[" + u + "," + v + "]}") != std::string::npos);
+    BOOST_CHECK(s.str().find("\"type\":\"boost::node<vertex") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(root_ptr_test20_escape)
+{
+    node_proxy x(__FILE__, "say \"hi\"\\\n\x1f", __LINE__);
+
+    std::ostringstream s;
+    dump_graph(x, s);
+    BOOST_CHECK(s.str().find("[shape=ellipse, label=\"say \\\"hi\\\"\\\\\\u000a\\u001f\"];") != std::string::npos);
+
+    s.str("");
+    dump_graph(x, s, graph_format::ndjson);
+    BOOST_CHECK(s.str().find(",\"function\":\"say \\\"hi\\\"\\\\\\u000a\\u001f\",") != std::string::npos);
+}
+
+struct wide {
+    wide(node_proxy const & x) : first(x), last(x) { }
+    root_ptr<int> first;
+    char pad[256];
+    root_ptr<int> last;
+};
+
+struct cell {
+    cell(node_proxy const & x) : p(x) { }
+    root_ptr<int> p;
+};
+
+BOOST_AUTO_TEST_CASE(root_ptr_test20_interior)
+{
+    node_proxy x(__FILE__, "root_ptr_test20_interior", __LINE__);
+    root_ptr<wide> a = make_root<wide>(x, x);
+    root_ptr<wide> b = make_root<wide>(x, x);
+    root_ptr<int> i = make_root<int>(x, 1);
+    root_ptr<int> j = make_root<int>(x, 2);
+    root_ptr<cell[]> c = make_root<cell[]>(x, 3, x);
+    a->first = i;
+    a->last = j;
+    b->last = i;
+    c[2].p = j;
+
+    std::string const u = quoted(& * a), w = quoted(& * b), k = quoted(& * i), l = quoted(& * j), e = quoted(& c[0]), y = quoted(& x);
+    std::ostringstream s;
+    dump_graph(x, s);
+    std::string const g = s.str();
+
+    // from the enclosing pointee object, wherever the pointer lies in it
+    BOOST_CHECK(g.find(u + " -> " + k) != std::string::npos);
+    BOOST_CHECK(g.find(u + " -> " + l) != std::string::npos);
+    BOOST_CHECK(g.find(w + " -> " + k) != std::string::npos);
+    BOOST_CHECK(g.find(w + " -> " + l) == std::string::npos);
+    // from the start of the array, for any of its elements
+    BOOST_CHECK(g.find(e + " -> " + l) != std::string::npos);
+    BOOST_CHECK(g.find(quoted(& c[2]) + " -> ") == std::string::npos);
+
+    // held outside of any node
+    BOOST_CHECK(g.find(y + " -> " + u) != std::string::npos);
+    BOOST_CHECK(g.find(y + " -> " + e) != std::string::npos);
+}
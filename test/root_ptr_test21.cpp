@@ -0,0 +1,71 @@
+/**
+	@file
+	root_ptr_test21.cpp
+
+	@note
+	Lifetime histograms of nodes by type.
+
+	Distributed under the Boost Software License, Version 1.0.
+
+	See accompanying file LICENSE_1_0.txt or copy at
+	http://www.boost.org/LICENSE_1_0.txt
+*/
+
+
+#define BOOST_SMART_PTR_LIFETIME
+
+#include <boost/smart_ptr/root_ptr.hpp>
+#include <boost/smart_ptr/lifetime_profile.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <sstream>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#include <boost/test/unit_test.hpp>
+
+using namespace boost;
+
+struct brief { int i; };
+struct durable { int i; };
+
+BOOST_AUTO_TEST_CASE(root_ptr_test21_lifetime)
+{
+    {
+        std::vector<std::unique_ptr<root_ptr<durable>>> v;
+        node_proxy x(__FILE__, "root_ptr_test21_lifetime", __LINE__);
+        for (int i = 0; i < 100; ++i) {
+            v.emplace_back(new root_ptr<durable>(x));
+            * v.back() = make_root<durable>(x);
+            // released right away
+            make_root<brief>(x);
+        }
+    }
+
+    lifetime_profile const p;
+    std::size_t n = 0;
+    for (lifetime_profile::type const & t : p.types())
+        if (t.name_.find("<brief") != std::string::npos) {
+            ++n;
+            BOOST_CHECK_EQUAL(t.ticks_[std::size_t(lifetime_end::refcount)].count_, 100u);
+            BOOST_CHECK_EQUAL(t.ticks_[std::size_t(lifetime_end::reset)].count_, 0u);
+            BOOST_CHECK_EQUAL(t.ticks_[std::size_t(lifetime_end::refcount)].percentile(100), 0u);
+        } else if (t.name_.find("<durable") != std::string::npos) {
+            ++n;
+            // still held when the node_proxy is destroyed
+            BOOST_CHECK_EQUAL(t.ticks_[std::size_t(lifetime_end::reset)].count_, 100u);
+            BOOST_CHECK_EQUAL(t.ticks_[std::size_t(lifetime_end::refcount)].count_, 0u);
+            // from 200 ticks for the first to 2 for the last
+            BOOST_CHECK_EQUAL(t.ticks_[std::size_t(lifetime_end::reset)].percentile(100), 255u);
+            BOOST_CHECK(t.ticks_[std::size_t(lifetime_end::reset)].percentile(50) >= 63u);
+            BOOST_CHECK(t.nanos_[std::size_t(lifetime_end::reset)].percentile(50) > 0u);
+        }
+    BOOST_CHECK_EQUAL(n, 2u);
+
+    std::ostringstream s;
+    p.text(s);
+    BOOST_CHECK(s.str().find("  reset: 100 nodes, ticks p50 ") != std::string::npos);
+}
@@ -0,0 +1,114 @@
+/**
+	@file
+	root_ptr_test22.cpp
+
+	@note
+	Quarantine of freed nodes.
+
+	Distributed under the Boost Software License, Version 1.0.
+
+	See accompanying file LICENSE_1_0.txt or copy at
+	http://www.boost.org/LICENSE_1_0.txt
+*/
+
+
+#define BOOST_SMART_PTR_QUARANTINE
+
+#include <boost/smart_ptr/root_ptr.hpp>
+#include <boost/smart_ptr/memory_report.hpp>
+
+#include <string>
+#include <vector>
+#include <sstream>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#include <boost/test/unit_test.hpp>
+
+using namespace boost;
+
+BOOST_AUTO_TEST_CASE(root_ptr_test22_quarantine)
+{
+    root_ptr<int> * q;
+    root_ptr<int[]> * r;
+    {
+        node_proxy x(__FILE__, "root_ptr_test22_quarantine", __LINE__);
+        root_ptr<int> p = make_root<int>(x, 1);
+        root_ptr<int[]> a = make_root<int[]>(x, 4);
+        root_ptr<int> c(x);
+        root_ptr<int[]> d(x);
+        c = p;
+        d = a;
+        // moved pointers are not enlisted, thus left dangling by the reset
+        q = new root_ptr<int>(std::move(c));
+        r = new root_ptr<int[]>(std::move(d));
+        x.reset();
+    }
+    BOOST_CHECK(quarantined_bytes() >= sizeof(node<int>));
+
+    try {
+        ** q;
+        BOOST_ERROR("no throw");
+    } catch (root_error const & e) {
+        BOOST_CHECK_EQUAL(e.kind(), root_error::use_after_free);
+        BOOST_CHECK(std::string(e.what()).find("use after free\n") == 0);
+    }
+    BOOST_CHECK_EQUAL(r->size(), 0u);
+    BOOST_CHECK_THROW((* r)[0], root_error);
+
+    // releasing a stale pointer leaves the node alone
+    delete q;
+    delete r;
+
+    quarantine_limit(2 * sizeof(node<int>));
+    {
+        node_proxy x(__FILE__, "root_ptr_test22_quarantine", __LINE__);
+        for (int i = 0; i < 100; ++i)
+            make_root<int>(x, i);
+        BOOST_CHECK(quarantined_bytes() <= 2 * sizeof(node<int>));
+    }
+    flush_quarantine();
+    BOOST_CHECK_EQUAL(quarantined_bytes(), 0u);
+    quarantine_limit(BOOST_SMART_PTR_QUARANTINE_BYTES);
+}
+
+struct item {
+    virtual ~item() { }
+    char data[40];
+};
+
+BOOST_AUTO_TEST_CASE(root_ptr_test22_report)
+{
+    flush_quarantine();
+    std::size_t const c = slab_allocator<node<item>>::pool().chunk_size();
+    {
+        node_proxy x(__FILE__, "root_ptr_test22_report", __LINE__);
+        std::vector<root_ptr<item>> v;
+        for (int i = 0; i < 10; ++i)
+            v.push_back(make_root<item>(x));
+        v.erase(v.begin() + 6, v.end());
+    }
+    BOOST_CHECK_EQUAL(quarantined_bytes(), 10 * sizeof(node<item>));
+
+    // nodes in quarantine are told apart instead of being inspected
+    memory_report r;
+    std::size_t n = 0;
+    for (memory_report::pool const & p : r.pools_)
+        if (p.chunk_size_ == c && p.nodes_)
+            n += p.quarantined_;
+    BOOST_CHECK_EQUAL(n, 10u);
+    BOOST_CHECK_EQUAL(r.quarantined_bytes_, 10 * c);
+    for (memory_report::type const & t : r.types_)
+        BOOST_CHECK(t.name_.find("item") == std::string::npos);
+
+    std::ostringstream s;
+    r.json(s);
+    BOOST_CHECK(s.str().find(",\"quarantined\":" + std::to_string(10 * c) + "}") != std::string::npos);
+    s.str("");
+    r.text(s);
+    BOOST_CHECK(s.str().find("quarantined: " + std::to_string(10 * c)) != std::string::npos);
+
+    flush_quarantine();
+    BOOST_CHECK_EQUAL(memory_report().quarantined_bytes_, 0u);
+}
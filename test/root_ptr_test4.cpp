@@ -0,0 +1,118 @@
+/**
+	@file
+	root_ptr_test4.cpp
+
+	@note
+	Biased reference counts shared across threads.
+
+	Distributed under the Boost Software License, Version 1.0.
+
+	See accompanying file LICENSE_1_0.txt or copy at
+	http://www.boost.org/LICENSE_1_0.txt
+*/
+
+
+#include <boost/smart_ptr/root_ptr.hpp>
+
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#include <boost/test/unit_test.hpp>
+
+using namespace boost;
+
+static std::atomic<int> count;
+
+struct item {
+    item() { ++count; }
+    ~item() { --count; }
+};
+
+BOOST_AUTO_TEST_CASE(root_ptr_test4_owner)
+{
+    node_proxy x(__FILE__, "root_ptr_test4_owner", __LINE__);
+    {
+        root_ptr<item> p(x, new node<item>());
+        {
+            root_ptr<item> q(p);
+        }
+        BOOST_CHECK_EQUAL(count, 1);
+    }
+    BOOST_CHECK_EQUAL(count, 0);
+}
+
+BOOST_AUTO_TEST_CASE(root_ptr_test4_negative_shared)
+{
+    node_proxy x(__FILE__, "root_ptr_test4_negative_shared", __LINE__);
+    for (int i = 0; i < 100; ++i) {
+        root_ptr<item> * p = new root_ptr<item>(x, new node<item>());
+        root_ptr<item> * q = new root_ptr<item>(* p);
+        // released by another thread than the owner: queued for an explicit merge
+        std::thread([&] { delete q; }).join();
+        BOOST_CHECK_EQUAL(count, 1);
+        delete p;
+        BOOST_CHECK_EQUAL(count, 0);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(root_ptr_test4_orphaned)
+{
+    node_proxy x(__FILE__, "root_ptr_test4_orphaned", __LINE__);
+    root_ptr<item> * p = 0;
+    std::thread([&] { p = new root_ptr<item>(x, new node<item>()); }).join();
+    {
+        root_ptr<item> q(* p);
+        delete p;
+        BOOST_CHECK_EQUAL(count, 1);
+    }
+    BOOST_CHECK_EQUAL(count, 0);
+}
+
+BOOST_AUTO_TEST_CASE(root_ptr_test4_concurrent)
+{
+    node_proxy x(__FILE__, "root_ptr_test4_concurrent", __LINE__);
+    {
+        root_ptr<item> p(x, new node<item>());
+        std::vector<std::thread> t;
+        for (int i = 0; i < 4; ++i)
+            t.emplace_back([&] { for (int j = 0; j < 10000; ++j) root_ptr<item> q(p); });
+        for (std::thread & i : t)
+            i.join();
+        BOOST_CHECK_EQUAL(count, 1);
+    }
+    BOOST_CHECK_EQUAL(count, 0);
+}
+
+BOOST_AUTO_TEST_CASE(root_ptr_test4_racing_release)
+{
+    for (int i = 0; i < 1000; ++i) {
+        node<item> * p = new node<item>();
+        // reference given to w
+        p->add_ref_copy();
+        std::atomic<bool> taken(false);
+        std::thread w, v;
+        {
+            // holds w between queueing the node and pushing it to the owner
+            std::scoped_lock guard(static_recursive_mutex());
+            w = std::thread([p] { p->release(); });
+            while (! (p->shared_.load() & node_base::queued))
+                std::this_thread::yield();
+            // reference taken by another thread and given back to the owner
+            v = std::thread([p, & taken] { p->add_ref_copy(); taken = true; });
+            while (! taken)
+                std::this_thread::yield();
+            p->release();
+            p->release();
+            BOOST_CHECK_EQUAL(count, 1);
+        }
+        w.join();
+        v.join();
+        biased_owner::current()->drain();
+        BOOST_CHECK_EQUAL(count, 0);
+    }
+}
@@ -0,0 +1,188 @@
+/**
+	@file
+	root_ptr_test5.cpp
+
+	@note
+	Slab pools prewarmed and returning free memory to the system, and memory reports.
+
+	Distributed under the Boost Software License, Version 1.0.
+
+	See accompanying file LICENSE_1_0.txt or copy at
+	http://www.boost.org/LICENSE_1_0.txt
+*/
+
+
+#include <boost/smart_ptr/root_ptr.hpp>
+#include <boost/smart_ptr/region_allocator.hpp>
+#include <boost/smart_ptr/memory_report.hpp>
+
+#include <chrono>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#include <boost/test/unit_test.hpp>
+
+using namespace boost;
+
+struct item {
+    char data[200];
+};
+
+typedef slab_allocator<node<item>> allocator;
+
+BOOST_AUTO_TEST_CASE(root_ptr_test5_release)
+{
+    smart_ptr::detail::slab_pool & pool = allocator::pool();
+    std::size_t const live = pool.live();
+    {
+        node_proxy x(__FILE__, "root_ptr_test5_release", __LINE__);
+        std::vector<root_ptr<item>> v;
+        for (int i = 0; i < 10000; ++i)
+            v.push_back(make_root<item>(x));
+        BOOST_CHECK_EQUAL(pool.live(), live + 10000);
+        BOOST_CHECK(pool.size() >= 10000 * sizeof(node<item>));
+    }
+    BOOST_CHECK_EQUAL(pool.live(), live);
+
+    std::size_t const size = pool.size();
+    std::size_t const released = release_memory();
+    BOOST_CHECK(released >= size - pool.size());
+    BOOST_CHECK(pool.size() < size);
+    BOOST_CHECK_EQUAL(release_memory(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(root_ptr_test5_keep)
+{
+    smart_ptr::detail::slab_pool & pool = allocator::pool();
+    {
+        node_proxy x(__FILE__, "root_ptr_test5_keep", __LINE__);
+        std::vector<root_ptr<item>> v;
+        for (int i = 0; i < 10000; ++i)
+            v.push_back(make_root<item>(x));
+    }
+    std::size_t const size = pool.size();
+    pool.release_memory(size);
+    BOOST_CHECK_EQUAL(pool.size(), size);
+    pool.release_memory();
+    BOOST_CHECK(pool.size() < size);
+}
+
+BOOST_AUTO_TEST_CASE(root_ptr_test5_trimmer)
+{
+    smart_ptr::detail::slab_pool & pool = allocator::pool();
+    memory_trimmer t(std::chrono::milliseconds(1));
+    {
+        node_proxy x(__FILE__, "root_ptr_test5_trimmer", __LINE__);
+        std::vector<root_ptr<item>> v;
+        for (int i = 0; i < 10000; ++i)
+            v.push_back(make_root<item>(x));
+    }
+    for (int i = 0; i < 1000 && t.released() == 0; ++i)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    BOOST_CHECK(t.released() > 0);
+    BOOST_CHECK_EQUAL(pool.live(), 0u);
+}
+
+struct other {
+    char data[300];
+};
+
+BOOST_AUTO_TEST_CASE(root_ptr_test5_prewarm)
+{
+    smart_ptr::detail::slab_pool & pool = allocator::pool();
+    prewarm<node<item>, node<other>>({5000, 1000});
+    BOOST_CHECK(pool.capacity() >= 5000);
+    BOOST_CHECK(slab_allocator<node<other>>::pool().capacity() >= 1000);
+    release_memory();
+    BOOST_CHECK(pool.capacity() >= 5000);
+    {
+        node_proxy x(__FILE__, "root_ptr_test5_prewarm", __LINE__);
+        std::size_t const size = pool.size();
+        std::vector<root_ptr<item>> v;
+        for (int i = 0; i < 5000; ++i)
+            v.push_back(make_root<item>(x));
+        BOOST_CHECK_EQUAL(pool.size(), size);
+    }
+}
+
+struct fixed {
+    char data[100];
+};
+
+BOOST_AUTO_TEST_CASE(root_ptr_test5_realtime)
+{
+    smart_ptr::detail::slab_pool & pool = slab_allocator<node<fixed>>::pool();
+    pool.realtime(1000);
+    std::size_t const capacity = pool.capacity();
+    BOOST_CHECK(capacity >= 1000);
+
+    node_proxy x(__FILE__, "root_ptr_test5_realtime", __LINE__);
+    std::vector<root_ptr<fixed>> v;
+    for (std::size_t i = 0; i < capacity; ++i)
+        v.push_back(make_root<fixed>(x));
+    BOOST_CHECK_THROW(make_root<fixed>(x), budget_exceeded);
+    v.clear();
+    release_memory();
+    BOOST_CHECK_EQUAL(pool.capacity(), capacity);
+
+    x.realtime(64 * 1024);
+    for (int j = 0; j < 2; ++j)
+    {
+        std::size_t const size = x.region_.size();
+        BOOST_CHECK_THROW(
+            for (;;) v.push_back(allocate_root<fixed>(x, region_allocator<fixed>(x))),
+            budget_exceeded);
+        BOOST_CHECK_EQUAL(x.region_.size(), size);
+        v.clear();
+        x.reset();
+    }
+}
+
+struct large {
+    char data[slab_allocator<int>::large_object];
+};
+
+BOOST_AUTO_TEST_CASE(root_ptr_test5_large)
+{
+    smart_ptr::detail::slab_pool & pool = slab_allocator<node<large>>::pool();
+    node_proxy x(__FILE__, "root_ptr_test5_large", __LINE__);
+    {
+        root_ptr<large> p = make_root<large>(x);
+        p->data[sizeof(large) - 1] = 1;
+        root_ptr<int[]> a = make_root<int[]>(x, slab_allocator<int>::large_object);
+        a[0] = 1;
+    }
+    prewarm<node<large>>(10);
+    BOOST_CHECK_EQUAL(pool.size(), 0u);
+    BOOST_CHECK_EQUAL(pool.live(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(root_ptr_test5_report)
+{
+    node_proxy x(__FILE__, "root_ptr_test5_report", __LINE__);
+    std::vector<root_ptr<item>> v;
+    for (int i = 0; i < 100; ++i)
+        v.push_back(make_root<item>(x));
+
+    memory_report r;
+    r.add(x);
+    bool found = false;
+    for (memory_report::type const & t : r.types_)
+        if (t.name_.find("item") != std::string::npos && t.chunk_size_ == allocator::pool().chunk_size())
+        {
+            found = true;
+            BOOST_CHECK_EQUAL(t.live_, 100u);
+            BOOST_CHECK_EQUAL(t.payload_, 100 * sizeof(item));
+            BOOST_CHECK_EQUAL(t.header_, 100 * (t.chunk_size_ - sizeof(item)));
+        }
+    BOOST_CHECK(found);
+    BOOST_CHECK_EQUAL(r.regions_.size(), 1u);
+
+    std::ostringstream s;
+    r.json(s);
+    BOOST_CHECK(s.str().find("\"types\":[") != std::string::npos);
+}
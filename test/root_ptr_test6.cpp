@@ -0,0 +1,85 @@
+/**
+	@file
+	root_ptr_test6.cpp
+
+	@note
+	Memory quotas of node_proxy.
+
+	Distributed under the Boost Software License, Version 1.0.
+
+	See accompanying file LICENSE_1_0.txt or copy at
+	http://www.boost.org/LICENSE_1_0.txt
+*/
+
+
+#include <boost/smart_ptr/root_ptr.hpp>
+#include <boost/smart_ptr/region_allocator.hpp>
+
+#include <vector>
+
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#include <boost/test/unit_test.hpp>
+
+using namespace boost;
+
+struct item {
+    char data[100];
+};
+
+BOOST_AUTO_TEST_CASE(root_ptr_test6_objects)
+{
+    memory_quota q(std::size_t(-1), 100);
+    {
+        node_proxy x(__FILE__, "root_ptr_test6_objects", __LINE__);
+        x.quota(& q);
+        node_proxy y(__FILE__, "root_ptr_test6_objects", __LINE__, & x);
+        BOOST_CHECK_EQUAL(y.quota(), & q);
+
+        std::vector<root_ptr<item>> v;
+        for (int i = 0; i < 100; ++i)
+            v.push_back(make_root<item>(y));
+        BOOST_CHECK_EQUAL(q.objects(), 100u);
+        BOOST_CHECK_EQUAL(q.bytes(), 100 * sizeof(node<item>));
+        BOOST_CHECK_THROW(make_root<item>(y), quota_exceeded);
+        BOOST_CHECK_THROW(make_nodes<item>(y, 1), quota_exceeded);
+        BOOST_CHECK_EQUAL(q.objects(), 100u);
+
+        v.resize(50, root_ptr<item>(y));
+        BOOST_CHECK_EQUAL(q.objects(), 50u);
+        std::vector<root_ptr<item>> w = make_nodes<item>(y, 50);
+        BOOST_CHECK_EQUAL(q.objects(), 100u);
+    }
+    BOOST_CHECK_EQUAL(q.objects(), 0u);
+    BOOST_CHECK_EQUAL(q.bytes(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(root_ptr_test6_bytes)
+{
+    memory_quota q(100000);
+    int high = 0, low = 0;
+    q.watermarks(80000, 20000, [&](memory_quota &) { ++high; }, [&](memory_quota &) { ++low; });
+    {
+        node_proxy x(__FILE__, "root_ptr_test6_bytes", __LINE__);
+        x.quota(& q);
+
+        std::vector<int, region_allocator<int>> r{region_allocator<int>(x)};
+        r.reserve(1000);
+        BOOST_CHECK_EQUAL(q.bytes(), 1000 * sizeof(int));
+        BOOST_CHECK_THROW(r.reserve(100000), quota_exceeded);
+
+        std::vector<root_ptr<int[]>> v;
+        while (high == 0)
+            v.push_back(make_root<int[]>(x, 1000));
+        BOOST_CHECK_THROW(for (;;) v.push_back(make_root<int[]>(x, 1000)), quota_exceeded);
+        BOOST_CHECK(q.bytes() <= q.max_bytes());
+        BOOST_CHECK_EQUAL(low, 0);
+        v.clear();
+        BOOST_CHECK_EQUAL(low, 1);
+        BOOST_CHECK_EQUAL(q.bytes(), 1000 * sizeof(int));
+    }
+    BOOST_CHECK_EQUAL(q.bytes(), 0u);
+    BOOST_CHECK_EQUAL(high, 1);
+}
@@ -0,0 +1,86 @@
+/**
+	@file
+	root_ptr_test7.cpp
+
+	@note
+	Reports of the checked build written to a file, including from thread exits.
+
+	Distributed under the Boost Software License, Version 1.0.
+
+	See accompanying file LICENSE_1_0.txt or copy at
+	http://www.boost.org/LICENSE_1_0.txt
+*/
+
+
+#define BOOST_REPORT
+
+#include <boost/smart_ptr/root_ptr.hpp>
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <iterator>
+#include <thread>
+
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#include <boost/test/unit_test.hpp>
+
+using namespace boost;
+
+BOOST_AUTO_TEST_CASE(root_ptr_test7_json)
+{
+    char const * path = "root_ptr_test7.json";
+    report_to(path);
+    {
+        node_proxy x(__FILE__, "root_ptr_test7_json", __LINE__);
+        for (int i = 0; i < 1000; ++i)
+            make_root<int>(x, i);
+    }
+    flush_reports();
+
+    std::ifstream f(path);
+    std::string const s((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+    std::size_t n = 0;
+    for (std::size_t i = 0; (i = s.find('\n', i)) != std::string::npos; ++i)
+        ++n;
+
+    // deduplicated: reported at 1, 2, 4, ... 512 occurrences
+    BOOST_CHECK_EQUAL(n, 10u);
+    BOOST_CHECK(s.find("\"event\":\"memory leak\",\"count\":512") != std::string::npos);
+    BOOST_CHECK(s.find("\"function\":\"root_ptr_test7_json\"") != std::string::npos);
+    std::remove(path);
+}
+
+struct late {
+    ~late()
+    {
+        node_proxy x(__FILE__, "late", __LINE__);
+        make_root<int>(x, 0);
+    }
+};
+
+BOOST_AUTO_TEST_CASE(root_ptr_test7_late)
+{
+    char const * path = "root_ptr_test7_late.json";
+    report_to(path);
+    std::thread([]
+    {
+        // destroyed after the ring of the thread
+        static thread_local late l;
+        (void) l;
+        node_proxy x(__FILE__, "early", __LINE__);
+        make_root<int>(x, 0);
+    }).join();
+    flush_reports();
+
+    std::ifstream f(path);
+    std::string const s((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+    BOOST_CHECK(s.find("\"function\":\"early\"") != std::string::npos);
+    BOOST_CHECK(s.find("\"function\":\"late\"") != std::string::npos);
+    std::remove(path);
+}
@@ -0,0 +1,124 @@
+/**
+	@file
+	root_ptr_test8.cpp
+
+	@note
+	Tracing hooks and conversion of a trace file to Chrome tracing.
+
+	Distributed under the Boost Software License, Version 1.0.
+
+	See accompanying file LICENSE_1_0.txt or copy at
+	http://www.boost.org/LICENSE_1_0.txt
+*/
+
+
+#define BOOST_SMART_PTR_TRACE
+
+#include <boost/smart_ptr/root_ptr.hpp>
+#include <boost/smart_ptr/trace.hpp>
+
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fstream>
+#include <sstream>
+
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#include <boost/test/unit_test.hpp>
+
+using namespace boost;
+
+struct recorder : trace_sink {
+    std::vector<trace_event> events;
+
+    void write(trace_event const * p, std::size_t n) override {
+        events.insert(events.end(), p, p + n);
+    }
+
+    std::size_t count(trace_kind k, std::uintptr_t a = 0) const {
+        std::size_t n = 0;
+        for (trace_event const & e : events)
+            if (e.kind_ == k && (! a || e.address_ == a))
+                ++n;
+        return n;
+    }
+};
+
+BOOST_AUTO_TEST_CASE(root_ptr_test8_events)
+{
+    recorder r;
+    trace_to(& r);
+    // address of the node_proxy, compared once it is gone
+    std::uintptr_t y;
+    {
+        node_proxy x(__FILE__, "root_ptr_test8_events", __LINE__);
+        y = reinterpret_cast<std::uintptr_t>(& x);
+        root_ptr<int> p = make_root<int>(x, 1);
+        {
+            root_ptr<int> q(p);
+        }
+        for (int i = 0; i < 2000; ++i)
+            make_root<int>(x, i);
+    }
+    trace_to(nullptr);
+
+    BOOST_CHECK_EQUAL(r.count(trace_kind::allocate), 2001u);
+    BOOST_CHECK_EQUAL(r.count(trace_kind::free), 2001u);
+    BOOST_CHECK_EQUAL(r.count(trace_kind::share), 1u);
+    BOOST_CHECK_EQUAL(r.count(trace_kind::proxy_construct, y), 1u);
+    BOOST_CHECK_EQUAL(r.count(trace_kind::proxy_destruct, y), 1u);
+
+    // phases of the reset in order, within the lifetime of the node_proxy
+    std::vector<trace_kind> v;
+    for (trace_event const & e : r.events)
+        if (e.address_ == y)
+            v.push_back(e.kind_);
+    std::vector<trace_kind> const w = {trace_kind::proxy_construct, trace_kind::reset_begin, trace_kind::reset_detached, trace_kind::reset_destroyed, trace_kind::reset_released, trace_kind::proxy_destruct};
+    BOOST_CHECK(v == w);
+
+    for (std::size_t i = 1; i < r.events.size(); ++i)
+        BOOST_CHECK(r.events[i - 1].time_ <= r.events[i].time_);
+
+    // off
+    std::size_t const n = r.events.size();
+    {
+        node_proxy x(__FILE__, "off", __LINE__);
+        make_root<int>(x, 0);
+    }
+    BOOST_CHECK_EQUAL(r.events.size(), n);
+}
+
+BOOST_AUTO_TEST_CASE(root_ptr_test8_chrome)
+{
+    char const * path = "root_ptr_test8.bin";
+    {
+        trace_file f(path);
+        trace_to(& f);
+        node_proxy x(__FILE__, "root_ptr_test8_chrome", __LINE__);
+        std::thread([&] {
+            node_proxy y(__FILE__, "thread", __LINE__, & x);
+            make_root<int>(y, 0);
+        }).join();
+        make_root<int>(x, 0);
+    }
+
+    std::ifstream in(path, std::ios::binary);
+    std::ostringstream out;
+    BOOST_CHECK(chrome_trace(in, out));
+    std::string const s = out.str();
+    BOOST_CHECK(s.find("\"traceEvents\":[") != std::string::npos);
+    BOOST_CHECK(s.find("\"name\":\"allocate\"") != std::string::npos);
+    BOOST_CHECK(s.find("\"name\":\"node_proxy::reset\",\"cat\":\"node_proxy\",\"ph\":\"X\"") != std::string::npos);
+    BOOST_CHECK(s.find("\"name\":\"destroy\"") != std::string::npos);
+    BOOST_CHECK(s.find("\"tid\":2") != std::string::npos);
+    BOOST_CHECK(s.find("\"bytes\":0}") != std::string::npos);
+    BOOST_CHECK_EQUAL(s.substr(s.size() - 4), "\n]}\n");
+    std::remove(path);
+
+    std::istringstream bad("not a trace");
+    BOOST_CHECK(! chrome_trace(bad, out));
+}
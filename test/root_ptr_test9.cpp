@@ -0,0 +1,96 @@
+/**
+	@file
+	root_ptr_test9.cpp
+
+	@note
+	Per-thread counters and their export in the OpenMetrics text format.
+
+	Distributed under the Boost Software License, Version 1.0.
+
+	See accompanying file LICENSE_1_0.txt or copy at
+	http://www.boost.org/LICENSE_1_0.txt
+*/
+
+
+#include <boost/smart_ptr/root_ptr.hpp>
+#include <boost/smart_ptr/root_stats.hpp>
+
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <iterator>
+
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#include <boost/test/unit_test.hpp>
+
+using namespace boost;
+
+BOOST_AUTO_TEST_CASE(root_ptr_test9_counters)
+{
+    root_statistics const a = root_stats();
+    {
+        node_proxy x(__FILE__, "root_ptr_test9_counters", __LINE__);
+        std::vector<root_ptr<int>> v;
+        for (int i = 0; i < 100; ++i)
+            v.push_back(make_root<int>(x, i));
+        root_ptr<int> p(v.front());
+
+        std::vector<std::thread> t;
+        for (int i = 0; i < 4; ++i)
+            t.emplace_back([&] {
+                node_proxy y(__FILE__, "thread", __LINE__, & x);
+                for (int j = 0; j < 1000; ++j)
+                    make_root<int>(y, j);
+            });
+        for (std::thread & i : t)
+            i.join();
+
+        root_statistics const b = root_stats();
+        BOOST_CHECK_EQUAL(b.allocations_ - a.allocations_, 4100u);
+        BOOST_CHECK_EQUAL(b.frees_ - a.frees_, 4000u);
+        BOOST_CHECK_EQUAL(b.live_nodes() - a.live_nodes(), 100u);
+        BOOST_CHECK_EQUAL(b.live_bytes() - a.live_bytes(), 100 * sizeof(node<int>));
+        BOOST_CHECK_EQUAL(b.live_proxies() - a.live_proxies(), 1u);
+        BOOST_CHECK_EQUAL(b.proxies_created_ - a.proxies_created_, 5u);
+        BOOST_CHECK(b.copies_ - a.copies_ >= 1u);
+        BOOST_CHECK(b.locks_ > a.locks_);
+    }
+    root_statistics const c = root_stats();
+    BOOST_CHECK_EQUAL(c.live_nodes(), a.live_nodes());
+    BOOST_CHECK_EQUAL(c.live_proxies(), a.live_proxies());
+}
+
+BOOST_AUTO_TEST_CASE(root_ptr_test9_openmetrics)
+{
+    std::ostringstream s;
+    root_statistics const a = {3, 1, 96, 32, 2, 1, 5, 7};
+    write_openmetrics(s, a);
+    BOOST_CHECK(s.str().find("# TYPE root_ptr_allocations counter\n") != std::string::npos);
+    BOOST_CHECK(s.str().find("\nroot_ptr_allocations_total 3\n") != std::string::npos);
+    BOOST_CHECK(s.str().find("\nroot_ptr_live_bytes 64\n") != std::string::npos);
+    BOOST_CHECK(s.str().find("\nroot_ptr_live_proxies 1\n") != std::string::npos);
+    BOOST_CHECK(s.str().find("\nroot_ptr_lock_acquisitions_total 7\n") != std::string::npos);
+    BOOST_CHECK_EQUAL(s.str().substr(s.str().size() - 6), "# EOF\n");
+
+    char const * path = "root_ptr_test9.prom";
+    {
+        root_stats_writer w(path, std::chrono::milliseconds(10));
+        node_proxy x(__FILE__, "root_ptr_test9_openmetrics", __LINE__);
+        root_ptr<int> p = make_root<int>(x, 0);
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+        std::ifstream f(path);
+        std::string const t((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+        BOOST_CHECK(t.find("root_ptr_live_nodes ") != std::string::npos);
+        BOOST_CHECK(t.find("# EOF\n") != std::string::npos);
+    }
+    std::ifstream f(std::string(path) + ".tmp");
+    BOOST_CHECK(! f);
+    std::remove(path);
+}